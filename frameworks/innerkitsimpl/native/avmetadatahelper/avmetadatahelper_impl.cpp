@@ -103,15 +103,9 @@ static PixelMapMemHolder *CreatePixelMapData(const std::shared_ptr<AVSharedMemor
     return holder;
 }
 
-static std::shared_ptr<PixelMap> CreatePixelMap(const std::shared_ptr<AVSharedMemory> &mem, PixelFormat color)
+static std::shared_ptr<PixelMap> CreatePixelMap(const std::shared_ptr<AVSharedMemory> &mem,
+    const OutputFrame *frame, PixelFormat color)
 {
-    CHECK_AND_RETURN_RET_LOG(mem != nullptr, nullptr, "Fetch frame failed");
-    CHECK_AND_RETURN_RET_LOG(mem->GetBase() != nullptr, nullptr, "Addr is nullptr");
-    CHECK_AND_RETURN_RET_LOG(mem->GetSize() > 0, nullptr, "size is incorrect");
-    CHECK_AND_RETURN_RET_LOG(static_cast<uint32_t>(mem->GetSize()) >= sizeof(OutputFrame),
-                             nullptr, "size is incorrect");
-
-    OutputFrame *frame = reinterpret_cast<OutputFrame *>(mem->GetBase());
     MEDIA_LOGD("width: %{public}d, stride : %{public}d, height: %{public}d, size: %{public}d, format: %{public}d",
         frame->width_, frame->stride_, frame->height_, frame->size_, color);
 
@@ -134,6 +128,62 @@ static std::shared_ptr<PixelMap> CreatePixelMap(const std::shared_ptr<AVSharedMe
     return pixelMap;
 }
 
+static std::shared_ptr<PixelMap> CreatePixelMap(const std::shared_ptr<AVSharedMemory> &mem, PixelFormat color)
+{
+    CHECK_AND_RETURN_RET_LOG(mem != nullptr, nullptr, "Fetch frame failed");
+    CHECK_AND_RETURN_RET_LOG(mem->GetBase() != nullptr, nullptr, "Addr is nullptr");
+    CHECK_AND_RETURN_RET_LOG(mem->GetSize() > 0, nullptr, "size is incorrect");
+    CHECK_AND_RETURN_RET_LOG(static_cast<uint32_t>(mem->GetSize()) >= sizeof(OutputFrame),
+                             nullptr, "size is incorrect");
+
+    return CreatePixelMap(mem, reinterpret_cast<OutputFrame *>(mem->GetBase()), color);
+}
+
+static OutputFrame *GetBatchFrame(const std::shared_ptr<AVSharedMemory> &mem, int32_t offset)
+{
+    static const int32_t frameHeaderSize = static_cast<int32_t>(sizeof(OutputFrame));
+    if (offset < 0 || offset > mem->GetSize() - frameHeaderSize) {
+        return nullptr;
+    }
+
+    OutputFrame *frame = reinterpret_cast<OutputFrame *>(mem->GetBase() + offset);
+    if (frame->size_ < 0 || frame->size_ > mem->GetSize() - offset - frameHeaderSize) {
+        return nullptr;
+    }
+    return frame;
+}
+
+static std::vector<std::shared_ptr<PixelMap>> CreatePixelMaps(const std::shared_ptr<AVSharedMemory> &mem,
+    size_t expectedCount, PixelFormat color)
+{
+    CHECK_AND_RETURN_RET_LOG(mem != nullptr, {}, "Fetch frames failed");
+    CHECK_AND_RETURN_RET_LOG(mem->GetBase() != nullptr, {}, "Addr is nullptr");
+    CHECK_AND_RETURN_RET_LOG(static_cast<uint32_t>(mem->GetSize()) >= sizeof(OutputFrameBatch), {},
+        "size is incorrect");
+
+    OutputFrameBatch *batch = reinterpret_cast<OutputFrameBatch *>(mem->GetBase());
+    CHECK_AND_RETURN_RET_LOG(batch->frameCount_ >= 0 && static_cast<size_t>(batch->frameCount_) == expectedCount,
+        {}, "frame count is incorrect: %{public}d", batch->frameCount_);
+    CHECK_AND_RETURN_RET_LOG(OutputFrameBatch::GetHeaderSize(batch->frameCount_) <= mem->GetSize(), {},
+        "size is incorrect");
+
+    std::vector<std::shared_ptr<PixelMap>> pixelMaps;
+    int32_t *offsets = batch->GetOffsets();
+    for (int32_t i = 0; i < batch->frameCount_; i++) {
+        std::shared_ptr<PixelMap> pixelMap = nullptr;
+        OutputFrame *frame = GetBatchFrame(mem, offsets[i]);
+        if (frame != nullptr) {
+            // every pixelmap referring to the shared memory holds it until the pixelmap freed
+            pixelMap = CreatePixelMap(mem, frame, color);
+        }
+        if (pixelMap == nullptr) {
+            MEDIA_LOGW("the frame at index %{public}d is unavailable", i);
+        }
+        pixelMaps.push_back(pixelMap);
+    }
+    return pixelMaps;
+}
+
 std::shared_ptr<AVMetadataHelper> AVMetadataHelperFactory::CreateAVMetadataHelper()
 {
     std::shared_ptr<AVMetadataHelperImpl> impl = std::make_shared<AVMetadataHelperImpl>();
@@ -207,6 +257,22 @@ std::shared_ptr<PixelMap> AVMetadataHelperImpl::FetchFrameAtTime(
     return CreatePixelMap(mem, param.colorFormat);
 }
 
+std::vector<std::shared_ptr<PixelMap>> AVMetadataHelperImpl::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const PixelMapParams &param)
+{
+    CHECK_AND_RETURN_RET_LOG(avMetadataHelperService_ != nullptr, {},
+        "avmetadatahelper service does not exist.");
+    CHECK_AND_RETURN_RET_LOG(!timesUs.empty(), {}, "timestamps are empty.");
+
+    OutputConfiguration config;
+    config.colorFormat = param.colorFormat;
+    config.dstHeight = param.dstHeight;
+    config.dstWidth = param.dstWidth;
+
+    auto mem = avMetadataHelperService_->FetchFramesAtTimes(timesUs, option, config);
+    return CreatePixelMaps(mem, timesUs.size(), param.colorFormat);
+}
+
 void AVMetadataHelperImpl::Release()
 {
     CHECK_AND_RETURN_LOG(avMetadataHelperService_ != nullptr, "avmetadatahelper service does not exist.");
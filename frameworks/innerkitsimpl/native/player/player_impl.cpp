@@ -210,6 +210,21 @@ int32_t PlayerImpl::SetLooping(bool loop)
     return playerService_->SetLooping(loop);
 }
 
+int32_t PlayerImpl::SetNextSource(const std::string &url)
+{
+    CHECK_AND_RETURN_RET_LOG(playerService_ != nullptr, MSERR_INVALID_OPERATION, "player service does not exist..");
+    CHECK_AND_RETURN_RET_LOG(!url.empty(), MSERR_INVALID_VAL, "url is empty..");
+
+    return playerService_->SetNextSource(url);
+}
+
+int32_t PlayerImpl::SetParameter(const Format &param)
+{
+    CHECK_AND_RETURN_RET_LOG(playerService_ != nullptr, MSERR_INVALID_OPERATION, "player service does not exist..");
+
+    return playerService_->SetParameter(param);
+}
+
 int32_t PlayerImpl::SetPlayerCallback(const std::shared_ptr<PlayerCallback> &callback)
 {
     CHECK_AND_RETURN_RET_LOG(playerService_ != nullptr, MSERR_INVALID_OPERATION, "player service does not exist..");
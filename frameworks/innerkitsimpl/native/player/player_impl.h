@@ -46,6 +46,8 @@ public:
     bool IsPlaying() override;
     bool IsLooping() override;
     int32_t SetLooping(bool loop) override;
+    int32_t SetNextSource(const std::string &url) override;
+    int32_t SetParameter(const Format &param) override;
     int32_t SetPlayerCallback(const std::shared_ptr<PlayerCallback> &callback) override;
     int32_t Init();
 private:
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <memory>
 #include "pixel_map.h"
 #include "nocopyable.h"
@@ -215,6 +216,21 @@ public:
      */
     virtual std::shared_ptr<PixelMap> FetchFrameAtTime(int64_t timeUs, int32_t option, const PixelMapParams &param) = 0;
 
+    /**
+     * Fetch the representative video frames near each of the given timestamps in one call. It
+     * is much cheaper than calling the {@link FetchFrameAtTime} repeatedly for a thumbnail strip,
+     * because the decoder state is shared among the nearby timestamps. This method must be called
+     * after the SetSource.
+     * @param timesUs The time positions in microseconds where the frames will be fetched, which
+     * must be sorted in ascending order and not be negative.
+     * @param option the hint about how to fetch a frame, see {@link AVMetadataQueryOption}
+     * @param param the desired configuration of returned pixelmaps, see {@link PixelMapParams}.
+     * @return Returns the pixelmaps in the same order with the timesUs. The pixelmap for the
+     * timestamp whose frame cannot be fetched is null. Returns empty vector on failure.
+     */
+    virtual std::vector<std::shared_ptr<PixelMap>> FetchFramesAtTimes(const std::vector<int64_t> &timesUs,
+        int32_t option, const PixelMapParams &param) = 0;
+
     /**
      * Release the internel resource. After this method called, the avmetadatahelper instance
      * can not be used again.
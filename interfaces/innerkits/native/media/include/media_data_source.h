@@ -51,6 +51,8 @@ public:
      * The memory length is greater than or equal to the length.
      * The length of the filled memory must match the actual length returned.
      * @return The actual length of stream mem filled, if failed or no mem return MediaDataSourceError.
+     * The player calls it from one thread at a time, unless PLAYER_DATASRC_READ_AHEAD_DEPTH is set greater
+     * than 1, then the calls for different positions may run concurrently.
      */
     virtual int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) = 0;
 
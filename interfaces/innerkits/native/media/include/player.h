@@ -25,6 +25,30 @@ namespace OHOS {
 namespace Media {
 const std::string PLAYER_WIDTH = "width";
 const std::string PLAYER_HEIGHT = "height";
+/* number of media data source reads kept in flight, int32 value in [1, 8], default 1. A value greater than 1
+   makes the player call IMediaDataSource::ReadAt(pos, length, mem) concurrently from several threads, so only
+   set it when that ReadAt is thread-safe. Ignored for the data source of size -1. */
+const std::string PLAYER_DATASRC_READ_AHEAD_DEPTH = "datasrc_read_ahead_depth";
+/* size in bytes of each media data source read, int32 value in [16384, 131072], 0 means adaptive. */
+const std::string PLAYER_DATASRC_BLOCK_SIZE = "datasrc_block_size";
+/* byte budget of the random access media data source cache, int32 value, 0 disables the cache. */
+const std::string PLAYER_DATASRC_CACHE_SIZE = "datasrc_cache_size";
+/* media data source cache counts reported by INFO_TYPE_EXTRA_FORMAT when the player stops reading the source,
+   int64 values accumulated since the source is set. */
+const std::string PLAYER_DATASRC_CACHE_HITS = "datasrc_cache_hits";
+const std::string PLAYER_DATASRC_CACHE_MISSES = "datasrc_cache_misses";
+const std::string PLAYER_DATASRC_CACHE_HIT_BYTES = "datasrc_cache_hit_bytes";
+const std::string PLAYER_DATASRC_CACHE_MISS_BYTES = "datasrc_cache_miss_bytes";
+/* video frame counts reported by INFO_TYPE_EXTRA_FORMAT, int64 values accumulated since the source is set. */
+const std::string PLAYER_VIDEO_FRAMES_RENDERED = "video_frames_rendered";
+const std::string PLAYER_VIDEO_FRAMES_DROPPED = "video_frames_dropped";
+const std::string PLAYER_VIDEO_FRAMES_LATE = "video_frames_late";
+/* silence in microseconds between the previous source and the next one, int64 value reported by
+   INFO_TYPE_EXTRA_FORMAT after PLAYER_INFO_NEXT_SOURCE_START. */
+const std::string PLAYER_NEXT_SOURCE_GAP = "next_source_gap";
+/* track counts of the next source, int32 values reported with PLAYER_NEXT_SOURCE_GAP. */
+const std::string PLAYER_NEXT_SOURCE_VIDEO_TRACKS = "next_source_video_tracks";
+const std::string PLAYER_NEXT_SOURCE_AUDIO_TRACKS = "next_source_audio_tracks";
 
 enum PlayerErrorType : int32_t {
     /* Valid error, error code reference defined in media_errors.h */
@@ -53,6 +77,8 @@ enum PlayerMessageType : int32_t {
     PLAYER_INFO_BUFFER_PERCENT,
     /* not fatal errors accured, errorcode see "media_errors.h" and passed by "extra"(arg 2). */
     PLAYER_INFO_WARNING,
+    /* the source set by SetNextSource starts to play without a state change. */
+    PLAYER_INFO_NEXT_SOURCE_START,
     /* system new info type should be added here.
        extend start. App and plugins or PlayerEngine extended info type start. */
     PLAYER_INFO_EXTEND_START = 0X1000,
@@ -126,6 +152,14 @@ enum PlaybackRateMode : int32_t {
     SPEED_FORWARD_1_75_X,
     /* Video playback at 2.0x normal speed */
     SPEED_FORWARD_2_00_X,
+    /* Video trick play at 8.0x normal speed, only the keyframes are decoded and the audio is muted */
+    SPEED_FORWARD_8_00_X,
+    /* Video trick play at 16.0x normal speed, only the keyframes are decoded and the audio is muted */
+    SPEED_FORWARD_16_00_X,
+    /* Video trick play backward at 8.0x normal speed, only the keyframes are decoded and the audio is muted */
+    SPEED_BACKWARD_8_00_X,
+    /* Video trick play backward at 16.0x normal speed, only the keyframes are decoded and the audio is muted */
+    SPEED_BACKWARD_16_00_X,
 };
 
 class PlayerCallback {
@@ -370,6 +404,38 @@ public:
      */
     virtual int32_t SetLooping(bool loop) = 0;
 
+    /**
+     * @brief Sets the source to play right after the current one, without the gap of a reset.
+     *
+     * The next source is prerolled shortly before the current one ends, and the playback switches to it
+     * instead of reporting the end of stream. {@link PLAYER_INFO_NEXT_SOURCE_START} is reported when it
+     * starts. The single looping takes precedence. This function must be called after {@link Prepare},
+     * and a new call replaces the previous next source which has not started yet.
+     *
+     * @param url Indicates the playback source, which must be a local file or network url.
+     * @return Returns {@link MSERR_OK} if the next source is set; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetNextSource(const std::string &url) = 0;
+
+    /**
+     * @brief Sets the parameters of the media data source reads.
+     *
+     * This function must be called after {@link SetSource} with an {@link IMediaDataSource} and before
+     * {@link Prepare}. Only the keys PLAYER_DATASRC_READ_AHEAD_DEPTH, PLAYER_DATASRC_BLOCK_SIZE and
+     * PLAYER_DATASRC_CACHE_SIZE are handled, the other keys are ignored.
+     *
+     * @param param the parameters to set.
+     * @return Returns {@link MSERR_OK} if the parameters are set; returns {@link MSERR_INVALID_OPERATION}
+     * if the source is not a media data source or the player is prepared already; returns another error code
+     * defined in {@link media_errors.h} otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetParameter(const Format &param) = 0;
+
     /**
      * @brief Method to set player callback.
      *
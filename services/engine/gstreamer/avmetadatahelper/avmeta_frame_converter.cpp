@@ -90,6 +90,37 @@ std::shared_ptr<AVSharedMemory> AVMetaFrameConverter::Convert(GstCaps &inCaps, G
     return GetConvertResult();
 }
 
+bool AVMetaFrameConverter::IsOutputConfigMatched(const OutputConfiguration &outConfig)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return outConfig_.dstWidth == outConfig.dstWidth && outConfig_.dstHeight == outConfig.dstHeight &&
+        outConfig_.colorFormat == outConfig.colorFormat;
+}
+
+bool AVMetaFrameConverter::IsInputCapsMatched(const GstCaps &inCaps)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return lastCaps_ != nullptr && gst_caps_is_equal(lastCaps_, &inCaps);
+}
+
+bool AVMetaFrameConverter::IsErrorOccurred()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return errorOccurred_;
+}
+
+void AVMetaFrameConverter::ReleaseResults()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (lastResult_ != nullptr) {
+        gst_buffer_unref(lastResult_);
+        lastResult_ = nullptr;
+    }
+
+    startConverting_ = false;
+}
+
 int32_t AVMetaFrameConverter::PrepareConvert(GstCaps &inCaps)
 {
     ON_SCOPE_EXIT(0) { (void)GetConvertResult(); };
@@ -143,7 +174,14 @@ std::shared_ptr<AVSharedMemory> AVMetaFrameConverter::GetConvertResult()
     CHECK_AND_RETURN_RET_LOG(mem != nullptr && mem->mem != nullptr, nullptr, "mem is nullptr");
     CHECK_AND_RETURN_RET_LOG(mem->mem->GetBase() != nullptr, nullptr, "addr is nullptr");
 
-    std::shared_ptr<AVSharedMemory> result = mem->mem;
+    /**
+     * The result holds the buffer until the caller releases it, then the buffer goes back to the bufferpool
+     * and its shared memory is filled by the later frames.
+     */
+    GstBuffer *resultBuf = gst_buffer_ref(lastResult_);
+    std::shared_ptr<AVSharedMemory> result(mem->mem.get(), [resultBuf](AVSharedMemory *) {
+        gst_buffer_unref(resultBuf);
+    });
     if (!(result->GetSize() > 0 && static_cast<uint32_t>(result->GetSize()) >= sizeof(OutputFrame))) {
         MEDIA_LOGE("size is incorrect");
         return nullptr;
@@ -214,11 +252,6 @@ int32_t AVMetaFrameConverter::Reset()
         lastCaps_ = nullptr;
     }
 
-    for (auto &sample : allResults_) {
-        gst_buffer_unref(sample);
-    }
-    allResults_.clear();
-
     startConverting_ = false;
     cond_.notify_all();
 
@@ -347,6 +380,7 @@ void AVMetaFrameConverter::OnNotifyMessage(const InnerMessage &msg)
         }
         case InnerMsgType::INNER_MSG_ERROR: {
             startConverting_ = false;
+            errorOccurred_ = true;
             MEDIA_LOGE("error happened");
             cond_.notify_all();
             break;
@@ -380,9 +414,6 @@ GstFlowReturn AVMetaFrameConverter::OnNotifyNewSample(GstElement *elem, AVMetaFr
     thiz->lastResult_ = gst_buffer_ref(buffer);
     CHECK_AND_RETURN_RET(thiz->lastResult_ != nullptr, GST_FLOW_ERROR);
 
-    // increase the refcount to avoid the buffer to be released to bufferpool.
-    thiz->allResults_.push_back(gst_buffer_ref(buffer));
-
     thiz->cond_.notify_all();
     return GST_FLOW_OK;
 }
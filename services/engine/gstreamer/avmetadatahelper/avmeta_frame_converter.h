@@ -34,6 +34,10 @@ public:
 
     int32_t Init(const OutputConfiguration &outConfig);
     std::shared_ptr<AVSharedMemory> Convert(GstCaps &inCaps, GstBuffer &inBuf);
+    bool IsOutputConfigMatched(const OutputConfiguration &outConfig);
+    bool IsInputCapsMatched(const GstCaps &inCaps);
+    bool IsErrorOccurred();
+    void ReleaseResults();
 
     DISALLOW_COPY_AND_MOVE(AVMetaFrameConverter);
 
@@ -61,7 +65,7 @@ private:
     std::mutex mutex_;
     std::condition_variable cond_;
     bool startConverting_ = false;
-    std::vector<GstBuffer *> allResults_;
+    bool errorOccurred_ = false;
 };
 }
 }
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avmeta_frame_converter_pool.h"
+#include "media_errors.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVMetaFrameConvPool"};
+    constexpr size_t MAX_IDLE_CONVERTERS = 4;
+}
+
+namespace OHOS {
+namespace Media {
+AVMetaFrameConverterPool &AVMetaFrameConverterPool::GetInstance()
+{
+    static AVMetaFrameConverterPool instance;
+    return instance;
+}
+
+AVMetaFrameConverterPool::AVMetaFrameConverterPool()
+{
+    MEDIA_LOGD("enter ctor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
+}
+
+AVMetaFrameConverterPool::~AVMetaFrameConverterPool()
+{
+    MEDIA_LOGD("enter dtor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
+    Clear();
+}
+
+std::unique_ptr<AVMetaFrameConverter> AVMetaFrameConverterPool::Acquire(
+    const OutputConfiguration &outConfig, const GstCaps &inCaps)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto candidate = idleConverters_.end();
+        for (auto it = idleConverters_.begin(); it != idleConverters_.end(); ++it) {
+            if (!(*it)->IsOutputConfigMatched(outConfig)) {
+                continue;
+            }
+            if ((*it)->IsInputCapsMatched(inCaps)) {
+                candidate = it;
+                break;
+            }
+            // the caps differ, the converter has to go through the READY state, but that is still cheaper
+            if (candidate == idleConverters_.end()) {
+                candidate = it;
+            }
+        }
+
+        if (candidate != idleConverters_.end()) {
+            auto converter = std::move(*candidate);
+            idleConverters_.erase(candidate);
+            MEDIA_LOGI("reuse converter, idle count: %{public}zu", idleConverters_.size());
+            return converter;
+        }
+    }
+
+    auto converter = std::make_unique<AVMetaFrameConverter>();
+    int32_t ret = converter->Init(outConfig);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, nullptr, "init converter failed");
+    MEDIA_LOGI("create new converter");
+    return converter;
+}
+
+void AVMetaFrameConverterPool::Recycle(std::unique_ptr<AVMetaFrameConverter> converter)
+{
+    CHECK_AND_RETURN(converter != nullptr);
+    if (converter->IsErrorOccurred()) {
+        MEDIA_LOGW("converter has error, drop it");
+        return;
+    }
+    converter->ReleaseResults();
+
+    std::unique_ptr<AVMetaFrameConverter> evicted;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idleConverters_.push_front(std::move(converter));
+        if (idleConverters_.size() > MAX_IDLE_CONVERTERS) {
+            evicted = std::move(idleConverters_.back());
+            idleConverters_.pop_back();
+        }
+    }
+    // destroying a converter waits for its pipeline and message thread, do it outside the lock
+    evicted = nullptr;
+}
+
+void AVMetaFrameConverterPool::Clear()
+{
+    decltype(idleConverters_) tempConverters;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        tempConverters.swap(idleConverters_);
+    }
+    tempConverters.clear();
+}
+}
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AVMETA_FRAME_CONVERTER_POOL_H
+#define AVMETA_FRAME_CONVERTER_POOL_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include "avmeta_frame_converter.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Keeps the idle converter pipelines of the process, so that the successive frame fetchings
+ * reuse a converter set up with the same input caps and output configuration.
+ */
+class AVMetaFrameConverterPool {
+public:
+    static AVMetaFrameConverterPool &GetInstance();
+    ~AVMetaFrameConverterPool();
+
+    std::unique_ptr<AVMetaFrameConverter> Acquire(const OutputConfiguration &outConfig, const GstCaps &inCaps);
+    void Recycle(std::unique_ptr<AVMetaFrameConverter> converter);
+    void Clear();
+
+    DISALLOW_COPY_AND_MOVE(AVMetaFrameConverterPool);
+
+private:
+    AVMetaFrameConverterPool();
+
+    std::mutex mutex_;
+    // the most recently recycled converter is at the front
+    std::list<std::unique_ptr<AVMetaFrameConverter>> idleConverters_;
+};
+}
+}
+
+#endif
@@ -25,6 +25,10 @@ namespace {
 
 namespace OHOS {
 namespace Media {
+// decoding forward from the last frame is cheaper than seeking when the target is within a gop.
+static constexpr int64_t MAX_ADVANCE_DISTANCE_US = 1000000;
+static constexpr int32_t ADVANCE_TIMEOUT_MS = 2000;
+
 AVMetaFrameExtractor::AVMetaFrameExtractor()
 {
     MEDIA_LOGD("enter ctor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
@@ -34,6 +38,10 @@ AVMetaFrameExtractor::~AVMetaFrameExtractor()
 {
     MEDIA_LOGD("enter dtor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
     Reset();
+    if (convertQue_ != nullptr) {
+        (void)convertQue_->Stop();
+        convertQue_ = nullptr;
+    }
 }
 
 int32_t AVMetaFrameExtractor::Init(const std::shared_ptr<IPlayBinCtrler> &playbin, GstElement &vidAppSink)
@@ -65,6 +73,140 @@ std::shared_ptr<AVSharedMemory> AVMetaFrameExtractor::ExtractFrame(
     return outFrames[0];
 }
 
+std::vector<std::shared_ptr<AVSharedMemory>> AVMetaFrameExtractor::ExtractFrames(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    std::vector<std::shared_ptr<AVSharedMemory>> outFrames(timesUs.size(), nullptr);
+
+    if (convertQue_ == nullptr) {
+        convertQue_ = std::make_unique<TaskQueue>("AVMetaConvert", true);
+        int32_t ret = convertQue_->Start();
+        CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, outFrames, "start convert queue failed");
+    }
+
+    std::unique_ptr<AVMetaFrameConverter> frameConverter = nullptr;
+    std::vector<std::pair<std::shared_ptr<TaskHandler<void>>, std::pair<GstBuffer *, GstCaps *>>> convertTasks;
+    int64_t lastPtsUs = -1;
+
+    for (size_t i = 0; i < timesUs.size(); i++) {
+        if (i > 0 && timesUs[i] == timesUs[i - 1]) {
+            continue; // duplicated timestamp shares the frame of the previous one
+        }
+
+        bool advance = (option == AV_META_QUERY_CLOSEST) && (lastPtsUs >= 0) && (timesUs[i] > lastPtsUs) &&
+            (timesUs[i] - lastPtsUs <= MAX_ADVANCE_DISTANCE_US);
+        auto item = FetchOriginalFrame(timesUs[i], option, advance);
+        if (item.first == nullptr && advance) {
+            MEDIA_LOGW("advance to %{public}" PRIi64 " failed, seek instead", timesUs[i]);
+            item = FetchOriginalFrame(timesUs[i], option, false);
+        }
+        if (item.first == nullptr) {
+            MEDIA_LOGE("extract frame at %{public}" PRIi64 " failed", timesUs[i]);
+            lastPtsUs = -1;
+            continue;
+        }
+        lastPtsUs = GST_BUFFER_PTS_IS_VALID(item.first) ?
+            static_cast<int64_t>(GST_TIME_AS_USECONDS(GST_BUFFER_PTS(item.first))) : -1;
+
+        if (frameConverter == nullptr) {
+            // the input caps are only known once the first frame arrives
+            frameConverter = AVMetaFrameConverterPool::GetInstance().Acquire(param, *item.second);
+        }
+        if (frameConverter == nullptr) {
+            gst_buffer_unref(item.first);
+            gst_caps_unref(item.second);
+            break;
+        }
+
+        // convert the frame while the pipeline is decoding the next one.
+        AVMetaFrameConverter *converter = frameConverter.get();
+        std::shared_ptr<AVSharedMemory> &outFrame = outFrames[i];
+        auto task = std::make_shared<TaskHandler<void>>([converter, item, &outFrame]() {
+            outFrame = converter->Convert(*item.second, *item.first);
+            gst_buffer_unref(item.first);
+            gst_caps_unref(item.second);
+        });
+        if (convertQue_->EnqueueTask(task) != MSERR_OK) {
+            gst_buffer_unref(item.first);
+            gst_caps_unref(item.second);
+            break;
+        }
+        convertTasks.push_back({ task, item });
+    }
+
+    bool convertFailed = false;
+    for (auto &[task, item] : convertTasks) {
+        if (!task->GetResult().HasResult()) {
+            // not executed, the frame is still owned here
+            gst_buffer_unref(item.first);
+            gst_caps_unref(item.second);
+            convertFailed = true;
+        }
+    }
+
+    for (size_t i = 0; i < outFrames.size(); i++) {
+        if (i > 0 && timesUs[i] == timesUs[i - 1]) {
+            outFrames[i] = outFrames[i - 1];
+        }
+        convertFailed = convertFailed || (outFrames[i] == nullptr);
+    }
+
+    if (frameConverter != nullptr && !convertFailed) {
+        AVMetaFrameConverterPool::GetInstance().Recycle(std::move(frameConverter));
+    }
+    MEDIA_LOGD("extract %{public}zu frames finished", outFrames.size());
+    return outFrames;
+}
+
+std::pair<GstBuffer *, GstCaps *> AVMetaFrameExtractor::FetchOriginalFrame(
+    int64_t timeUs, int32_t option, bool advance)
+{
+    std::pair<GstBuffer *, GstCaps *> item = { nullptr, nullptr };
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(playbin_ != nullptr, item, "extractor is reset");
+
+    ClearCache();
+    startExtracting_ = true;
+    maxFrames_ = 1;
+
+    int32_t ret;
+    if (advance) {
+        minPtsNs_ = timeUs * static_cast<int64_t>(GST_USECOND);
+        ret = playbin_->Play();
+    } else {
+        minPtsNs_ = -1;
+        ret = playbin_->Seek(timeUs, option);
+    }
+
+    if (ret == MSERR_OK) {
+        auto pred = [this]() { return !originalFrames_.empty() || !startExtracting_; };
+        if (!advance) {
+            cond_.wait(lock, pred);
+        } else if (!cond_.wait_for(lock, std::chrono::milliseconds(ADVANCE_TIMEOUT_MS), pred)) {
+            MEDIA_LOGW("no frame at %{public}" PRIi64 " arrived in time", timeUs);
+            (void)playbin_->Pause();
+        }
+    }
+
+    if (startExtracting_ && !originalFrames_.empty()) {
+        item = originalFrames_.front();
+        originalFrames_.pop();
+    }
+
+    minPtsNs_ = -1;
+    StopExtract();
+    return item;
+}
+
+bool AVMetaFrameExtractor::IsFrameAccepted(GstBuffer &buffer)
+{
+    if (minPtsNs_ < 0) {
+        return true;
+    }
+    return startExtracting_ && GST_BUFFER_PTS_IS_VALID(&buffer) &&
+        GST_BUFFER_PTS(&buffer) >= static_cast<GstClockTime>(minPtsNs_);
+}
+
 void AVMetaFrameExtractor::ClearCache()
 {
     while (!originalFrames_.empty()) {
@@ -101,9 +243,10 @@ void AVMetaFrameExtractor::Reset()
 std::vector<std::shared_ptr<AVSharedMemory>> AVMetaFrameExtractor::ExtractInternel()
 {
     std::vector<std::shared_ptr<AVSharedMemory>> outFrames;
+    std::unique_ptr<AVMetaFrameConverter> frameConverter = nullptr;
+    bool convertFailed = false;
 
     std::unique_lock<std::mutex> lock(mutex_);
-    auto frameConverter = std::move(frameConverter_);
 
     do {
         cond_.wait(lock, [this]() { return !originalFrames_.empty() || !startExtracting_; });
@@ -112,8 +255,17 @@ std::vector<std::shared_ptr<AVSharedMemory>> AVMetaFrameExtractor::ExtractIntern
         auto item = originalFrames_.front();
         lock.unlock();
 
-        auto outFrame = frameConverter->Convert(*item.second, *item.first);
-        CHECK_AND_BREAK_LOG(outFrame != nullptr, "convert frame failed");
+        if (frameConverter == nullptr) {
+            // the input caps are only known once the first frame arrives
+            frameConverter = AVMetaFrameConverterPool::GetInstance().Acquire(outConfig_, *item.second);
+        }
+        auto outFrame = frameConverter != nullptr ? frameConverter->Convert(*item.second, *item.first) : nullptr;
+        if (outFrame == nullptr) {
+            MEDIA_LOGE("convert frame failed");
+            convertFailed = true;
+            lock.lock();
+            break;
+        }
 
         outFrames.push_back(outFrame);
         MEDIA_LOGD("extract frame success, frame number: %{public}zu", outFrames.size());
@@ -127,6 +279,11 @@ std::vector<std::shared_ptr<AVSharedMemory>> AVMetaFrameExtractor::ExtractIntern
 
     MEDIA_LOGD("extract frame finished");
     StopExtract();
+    lock.unlock();
+
+    if (!convertFailed) {
+        AVMetaFrameConverterPool::GetInstance().Recycle(std::move(frameConverter));
+    }
     return outFrames;
 }
 
@@ -144,9 +301,7 @@ int32_t AVMetaFrameExtractor::StartExtract(
     int32_t ret = playbin_->Seek(timeUs, option);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "seek failed, cancel extract frames");
 
-    frameConverter_ = std::make_unique<AVMetaFrameConverter>();
-    ret = frameConverter_->Init(param);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "init failed, cancel extract frames");
+    outConfig_ = param;
 
     if (numFrames > 1) {
         ret = playbin_->Play(); // play to generate more frames
@@ -162,13 +317,14 @@ void AVMetaFrameExtractor::StopExtract()
     ClearCache();
     startExtracting_ = false;
     cond_.notify_all();
-    frameConverter_ = nullptr;
 }
 
 int32_t AVMetaFrameExtractor::SetupVideoSink()
 {
     g_object_set(G_OBJECT(vidAppSink_), "emit-signals", TRUE, nullptr);
     g_object_set(G_OBJECT(vidAppSink_), "max-buffers", 1, nullptr);
+    // the frames are decoded as fast as possible when playing to generate more frames
+    g_object_set(G_OBJECT(vidAppSink_), "sync", FALSE, nullptr);
 
     gulong signalId = g_signal_connect(G_OBJECT(vidAppSink_), "new-preroll", G_CALLBACK(OnNewPrerollArrived), this);
     CHECK_AND_RETURN_RET_LOG(signalId != 0, MSERR_INVALID_OPERATION, "listen to new-preroll failed");
@@ -199,7 +355,7 @@ GstFlowReturn AVMetaFrameExtractor::OnNewPrerollArrived(
     CHECK_AND_RETURN_RET(buffer != nullptr, GST_FLOW_ERROR);
     MEDIA_LOGI("preroll buffer arrived, pts: %{public}" PRIu64 "", GST_BUFFER_PTS(buffer));
 
-    if (!thiz->startExtracting_) {
+    if (!thiz->startExtracting_ || !thiz->IsFrameAccepted(*buffer)) {
         MEDIA_LOGI("not start extract, ignore");
         return GST_FLOW_OK;
     }
@@ -231,7 +387,11 @@ GstFlowReturn AVMetaFrameExtractor::OnNewSampleArrived(
     CHECK_AND_RETURN_RET(buffer != nullptr, GST_FLOW_ERROR);
     MEDIA_LOGI("sample buffer arrived, pts: %{public}" PRIu64 "", GST_BUFFER_PTS(buffer));
 
-    if (thiz->currOriginalFrameCount_ == 1) {
+    if (thiz->minPtsNs_ >= 0) {
+        if (!thiz->IsFrameAccepted(*buffer)) {
+            return GST_FLOW_OK; // decoded before the target when advancing, skip it
+        }
+    } else if (thiz->currOriginalFrameCount_ == 1) {
         MEDIA_LOGE("first sample, ignored"); // first sample is same with the preroll buffer
         return GST_FLOW_OK;
     }
@@ -21,7 +21,8 @@
 #include <mutex>
 #include <condition_variable>
 #include "avmetadatahelper_engine_gst_impl.h"
-#include "avmeta_frame_converter.h"
+#include "avmeta_frame_converter_pool.h"
+#include "task_queue.h"
 #include "nocopyable.h"
 
 namespace OHOS {
@@ -33,6 +34,8 @@ public:
 
     int32_t Init(const std::shared_ptr<IPlayBinCtrler> &playbin, GstElement &vidAppSink);
     std::shared_ptr<AVSharedMemory> ExtractFrame(int64_t timeUs, int32_t option, const OutputConfiguration &param);
+    std::vector<std::shared_ptr<AVSharedMemory>> ExtractFrames(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param);
     void Reset();
 
     DISALLOW_COPY_AND_MOVE(AVMetaFrameExtractor);
@@ -42,6 +45,8 @@ private:
     int32_t StartExtract(int32_t numFrames, int64_t timeUs, int32_t option, const OutputConfiguration &param);
     std::vector<std::shared_ptr<AVSharedMemory>> ExtractInternel();
     void StopExtract();
+    std::pair<GstBuffer *, GstCaps *> FetchOriginalFrame(int64_t timeUs, int32_t option, bool advance);
+    bool IsFrameAccepted(GstBuffer &buffer);
     void ClearCache();
 
     static GstFlowReturn OnNewPrerollArrived(GstElement *sink, AVMetaFrameExtractor *thiz);
@@ -55,7 +60,10 @@ private:
     std::mutex mutex_;
     std::condition_variable cond_;
     bool startExtracting_ = false;
-    std::unique_ptr<AVMetaFrameConverter> frameConverter_;
+    OutputConfiguration outConfig_;
+    // valid only when decoding forward to a target without seek, the earlier frames are skipped.
+    int64_t minPtsNs_ = -1;
+    std::unique_ptr<TaskQueue> convertQue_;
     std::vector<gulong> signalIds_;
 };
 }
@@ -14,7 +14,9 @@
  */
 
 #include "avmetadatahelper_engine_gst_impl.h"
+#include <algorithm>
 #include <gst/gst.h>
+#include "securec.h"
 #include "media_errors.h"
 #include "media_log.h"
 #include "i_playbin_ctrler.h"
@@ -32,6 +34,9 @@ namespace {
 namespace OHOS {
 namespace Media {
 static const std::set<PixelFormat> SUPPORTED_PIXELFORMAT = { PixelFormat::RGB_565, PixelFormat::RGB_888 };
+static constexpr size_t MAX_BATCH_FRAMES = 256;
+static constexpr int64_t MAX_BATCH_MEM_SIZE = 256 * 1024 * 1024;
+static constexpr int32_t BATCH_FRAME_ALIGN = 4;
 
 static bool CheckFrameFetchParam(int64_t timeUsOrIndex, int32_t option, const OutputConfiguration &param)
 {
@@ -153,6 +158,81 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperEngineGstImpl::FetchFrameAtTime(
     return outFrames[0];
 }
 
+std::shared_ptr<AVSharedMemory> AVMetadataHelperEngineGstImpl::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    MEDIA_LOGD("enter");
+
+    if (usage_ != AVMetadataUsage::AV_META_USAGE_PIXEL_MAP) {
+        MEDIA_LOGE("current instance is unavaiable for fetch frame, check usage !");
+        return nullptr;
+    }
+
+    CHECK_AND_RETURN_RET_LOG(!timesUs.empty() && timesUs.size() <= MAX_BATCH_FRAMES, nullptr,
+        "invalid frame count: %{public}zu", timesUs.size());
+    CHECK_AND_RETURN_RET_LOG(std::is_sorted(timesUs.begin(), timesUs.end()), nullptr,
+        "timestamps are not sorted in ascending order");
+    for (auto timeUs : timesUs) {
+        CHECK_AND_RETURN_RET_LOG(CheckFrameFetchParam(timeUs, option, param), nullptr,
+            "fetch frame's param invalid");
+    }
+
+    AUTO_PERF(this, "FetchFrames");
+
+    int32_t ret = PrepareFrameFetch();
+    CHECK_AND_RETURN_RET(ret == MSERR_OK, nullptr);
+
+    auto outFrames = frameExtractor_->ExtractFrames(timesUs, option, param);
+    auto batchMem = PackFrames(outFrames);
+    CHECK_AND_RETURN_RET_LOG(batchMem != nullptr, nullptr, "fetch frames failed");
+
+    if (firstFetch_) {
+        ASYNC_PERF_STOP(this, "FirstFetchFrame");
+        firstFetch_ = false;
+    }
+
+    MEDIA_LOGD("exit");
+    return batchMem;
+}
+
+std::shared_ptr<AVSharedMemory> AVMetadataHelperEngineGstImpl::PackFrames(
+    const std::vector<std::shared_ptr<AVSharedMemory>> &frames)
+{
+    int32_t frameCount = static_cast<int32_t>(frames.size());
+    int64_t totalSize = OutputFrameBatch::GetHeaderSize(frameCount);
+    bool hasFrame = false;
+    for (auto &frame : frames) {
+        if (frame != nullptr) {
+            totalSize += (frame->GetSize() + BATCH_FRAME_ALIGN - 1) / BATCH_FRAME_ALIGN * BATCH_FRAME_ALIGN;
+            hasFrame = true;
+        }
+    }
+    CHECK_AND_RETURN_RET_LOG(hasFrame, nullptr, "none of the frames is fetched");
+    CHECK_AND_RETURN_RET_LOG(totalSize <= MAX_BATCH_MEM_SIZE, nullptr,
+        "frames too large: %{public}" PRIi64, totalSize);
+
+    auto batchMem = AVSharedMemory::Create(static_cast<int32_t>(totalSize),
+        AVSharedMemory::Flags::FLAGS_READ_ONLY, "AVMetaFrameBatch");
+    CHECK_AND_RETURN_RET_LOG(batchMem != nullptr, nullptr, "create shared memory failed");
+
+    OutputFrameBatch *batch = new (batchMem->GetBase()) OutputFrameBatch(frameCount);
+    int32_t *offsets = batch->GetOffsets();
+    int32_t offset = OutputFrameBatch::GetHeaderSize(frameCount);
+    for (int32_t i = 0; i < frameCount; i++) {
+        if (frames[i] == nullptr) {
+            offsets[i] = -1;
+            continue;
+        }
+        errno_t rc = memcpy_s(batchMem->GetBase() + offset, static_cast<size_t>(batchMem->GetSize() - offset),
+            frames[i]->GetBase(), static_cast<size_t>(frames[i]->GetSize()));
+        CHECK_AND_RETURN_RET_LOG(rc == EOK, nullptr, "memcpy_s failed");
+        offsets[i] = offset;
+        offset += (frames[i]->GetSize() + BATCH_FRAME_ALIGN - 1) / BATCH_FRAME_ALIGN * BATCH_FRAME_ALIGN;
+    }
+
+    return batchMem;
+}
+
 int32_t AVMetadataHelperEngineGstImpl::SetSourceInternel(const std::string &uri, int32_t usage)
 {
     Reset();
@@ -238,18 +318,7 @@ int32_t AVMetadataHelperEngineGstImpl::FetchFrameInternel(int64_t timeUsOrIndex,
         return MSERR_INVALID_OPERATION;
     }
 
-    CHECK_AND_RETURN_RET_LOG(frameExtractor_ != nullptr, MSERR_INVALID_OPERATION, "frameExtractor is nullptr");
-
-    int32_t ret = ExtractMetadata();
-    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
-
-    if (collectedMeta_.find(AV_KEY_HAS_VIDEO) == collectedMeta_.end() ||
-        collectedMeta_[AV_KEY_HAS_VIDEO] != "yes") {
-        MEDIA_LOGE("There is no video track in the current media source !");
-        return MSERR_INVALID_OPERATION;
-    }
-
-    ret = PrepareInternel(false);
+    int32_t ret = PrepareFrameFetch();
     CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
     auto frame = frameExtractor_->ExtractFrame(timeUsOrIndex, option, param);
@@ -267,6 +336,22 @@ int32_t AVMetadataHelperEngineGstImpl::FetchFrameInternel(int64_t timeUsOrIndex,
     return MSERR_OK;
 }
 
+int32_t AVMetadataHelperEngineGstImpl::PrepareFrameFetch()
+{
+    CHECK_AND_RETURN_RET_LOG(frameExtractor_ != nullptr, MSERR_INVALID_OPERATION, "frameExtractor is nullptr");
+
+    int32_t ret = ExtractMetadata();
+    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+
+    if (collectedMeta_.find(AV_KEY_HAS_VIDEO) == collectedMeta_.end() ||
+        collectedMeta_[AV_KEY_HAS_VIDEO] != "yes") {
+        MEDIA_LOGE("There is no video track in the current media source !");
+        return MSERR_INVALID_OPERATION;
+    }
+
+    return PrepareInternel(false);
+}
+
 int32_t AVMetadataHelperEngineGstImpl::ExtractMetadata()
 {
     CHECK_AND_RETURN_RET_LOG(metaCollector_ != nullptr, MSERR_INVALID_OPERATION, "metaCollector is nullptr");
@@ -40,6 +40,8 @@ public:
     std::unordered_map<int32_t, std::string> ResolveMetadata() override;
     std::shared_ptr<AVSharedMemory> FetchFrameAtTime(
         int64_t timeUs, int32_t option, const OutputConfiguration &param) override;
+    std::shared_ptr<AVSharedMemory> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param) override;
 
 private:
     void OnNotifyMessage(const PlayBinMessage &msg);
@@ -48,6 +50,8 @@ private:
     int32_t PrepareInternel(bool async);
     int32_t FetchFrameInternel(int64_t timeUsOrIndex, int32_t option, int32_t numFrames,
         const OutputConfiguration &param, std::vector<std::shared_ptr<AVSharedMemory>> &outFrames);
+    int32_t PrepareFrameFetch();
+    std::shared_ptr<AVSharedMemory> PackFrames(const std::vector<std::shared_ptr<AVSharedMemory>> &frames);
     int32_t ExtractMetadata();
     void OnNotifyElemSetup(GstElement &elem);
     void Reset();
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gst_bus_dispatcher.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <pthread.h>
+#include "media_errors.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstBusDispatcher"};
+}
+
+namespace OHOS {
+namespace Media {
+struct GstBusWatch {
+    GSource *source_ = nullptr;
+    size_t contextIndex_ = 0;
+    GstBusFunc func_ = nullptr;
+    gpointer userData_ = nullptr;
+    // held while the func is running, the func may detach the watch itself.
+    std::recursive_mutex mutex_;
+    bool detached_ = false;
+    // one for the caller, one for the source's callback.
+    std::atomic<int32_t> refCount_ = 2;
+};
+
+GstBusDispatcher &GstBusDispatcher::Inst()
+{
+    // intentionally leaked, the context threads may still be running at exit.
+    static GstBusDispatcher *inst = new GstBusDispatcher();
+    return *inst;
+}
+
+GstBusWatch *GstBusDispatcher::Attach(GstBus &bus, GstBusFunc func, gpointer userData)
+{
+    CHECK_AND_RETURN_RET_LOG(func != nullptr, nullptr, "bus func is nullptr");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t index = 0;
+    for (size_t i = 1; i < CONTEXT_NUM; i++) {
+        if (contexts_[i].watchCount_ < contexts_[index].watchCount_) {
+            index = i;
+        }
+    }
+
+    DispatchContext &ctx = contexts_[index];
+    if (ctx.context_ == nullptr) {
+        CHECK_AND_RETURN_RET(StartContextLocked(ctx, index) == MSERR_OK, nullptr);
+    }
+
+    GSource *source = gst_bus_create_watch(&bus);
+    CHECK_AND_RETURN_RET_LOG(source != nullptr, nullptr, "create bus watch failed");
+
+    GstBusWatch *watch = new (std::nothrow) GstBusWatch();
+    if (watch == nullptr) {
+        MEDIA_LOGE("alloc bus watch failed");
+        g_source_unref(source);
+        return nullptr;
+    }
+    watch->source_ = source;
+    watch->contextIndex_ = index;
+    watch->func_ = func;
+    watch->userData_ = userData;
+
+    g_source_set_callback(source, (GSourceFunc)&GstBusDispatcher::BusCallback, watch, &GstBusDispatcher::UnrefWatch);
+    if (g_source_attach(source, ctx.context_) == 0) {
+        MEDIA_LOGE("attach bus watch failed");
+        g_source_unref(source);
+        UnrefWatch(watch);
+        return nullptr;
+    }
+
+    ctx.watchCount_++;
+    MEDIA_LOGI("attach bus watch 0x%{public}06" PRIXPTR " to context %{public}zu, watch count: %{public}u",
+        FAKE_POINTER(watch), index, ctx.watchCount_);
+    return watch;
+}
+
+void GstBusDispatcher::Detach(GstBusWatch *watch)
+{
+    CHECK_AND_RETURN(watch != nullptr);
+
+    {
+        // wait for the running func to finish.
+        std::unique_lock<std::recursive_mutex> lock(watch->mutex_);
+        watch->detached_ = true;
+    }
+
+    g_source_destroy(watch->source_);
+    g_source_unref(watch->source_);
+    watch->source_ = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        DispatchContext &ctx = contexts_[watch->contextIndex_];
+        ctx.watchCount_--;
+        MEDIA_LOGI("detach bus watch 0x%{public}06" PRIXPTR " from context %{public}zu, watch count: %{public}u",
+            FAKE_POINTER(watch), watch->contextIndex_, ctx.watchCount_);
+    }
+
+    UnrefWatch(watch);
+}
+
+gboolean GstBusDispatcher::BusCallback(GstBus *bus, GstMessage *msg, gpointer data)
+{
+    GstBusWatch *watch = reinterpret_cast<GstBusWatch *>(data);
+    CHECK_AND_RETURN_RET(watch != nullptr, G_SOURCE_REMOVE);
+
+    std::unique_lock<std::recursive_mutex> lock(watch->mutex_);
+    if (watch->detached_) {
+        return G_SOURCE_REMOVE;
+    }
+    return watch->func_(bus, msg, watch->userData_);
+}
+
+void GstBusDispatcher::UnrefWatch(gpointer data)
+{
+    GstBusWatch *watch = reinterpret_cast<GstBusWatch *>(data);
+    if (watch != nullptr && watch->refCount_.fetch_sub(1) == 1) {
+        delete watch;
+    }
+}
+
+int32_t GstBusDispatcher::StartContextLocked(DispatchContext &ctx, size_t index)
+{
+    GMainContext *context = g_main_context_new();
+    CHECK_AND_RETURN_RET_LOG(context != nullptr, MSERR_NO_MEMORY, "create main context failed");
+
+    GMainLoop *loop = g_main_loop_new(context, FALSE);
+    if (loop == nullptr) {
+        MEDIA_LOGE("create main loop failed");
+        g_main_context_unref(context);
+        return MSERR_NO_MEMORY;
+    }
+
+    ctx.context_ = context;
+    ctx.loop_ = loop;
+    // the loop never quits, the context lives as long as the process.
+    std::thread thread(&GstBusDispatcher::ContextLoop, &ctx, index);
+    thread.detach();
+    return MSERR_OK;
+}
+
+void GstBusDispatcher::ContextLoop(DispatchContext *ctx, size_t index)
+{
+    std::string name = "GstBusDispatch" + std::to_string(index);
+    (void)pthread_setname_np(pthread_self(), name.c_str());
+    g_main_context_push_thread_default(ctx->context_);
+
+    MEDIA_LOGI("start bus dispatch loop %{public}zu", index);
+    g_main_loop_run(ctx->loop_);
+    MEDIA_LOGI("stop bus dispatch loop %{public}zu", index);
+}
+}
+}
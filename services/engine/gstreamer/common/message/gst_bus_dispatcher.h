@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GST_BUS_DISPATCHER_H
+#define GST_BUS_DISPATCHER_H
+
+#include <array>
+#include <mutex>
+#include <gst/gst.h>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+struct GstBusWatch;
+
+/**
+ * Process-wide dispatcher for the pipelines' bus messages. The bus watches are attached to a small
+ * fixed set of shared main contexts instead of one main loop thread per pipeline. All messages of
+ * one bus are dispatched by the same context thread, so the per-pipeline message order is preserved.
+ */
+class GstBusDispatcher {
+public:
+    static GstBusDispatcher &Inst();
+
+    /**
+     * Attach the bus watch to the least loaded context. The func will be called at the context thread
+     * for each message until it returns FALSE or the watch is detached.
+     */
+    GstBusWatch *Attach(GstBus &bus, GstBusFunc func, gpointer userData);
+    /**
+     * Detach the bus watch. After return, the func is not running and will never be called again,
+     * the watch can not be used anymore.
+     */
+    void Detach(GstBusWatch *watch);
+
+    DISALLOW_COPY_AND_MOVE(GstBusDispatcher);
+
+private:
+    GstBusDispatcher() = default;
+    ~GstBusDispatcher() = default;
+
+    struct DispatchContext {
+        GMainContext *context_ = nullptr;
+        GMainLoop *loop_ = nullptr;
+        uint32_t watchCount_ = 0;
+    };
+
+    static gboolean BusCallback(GstBus *bus, GstMessage *msg, gpointer data);
+    static void UnrefWatch(gpointer data);
+    static void ContextLoop(DispatchContext *ctx, size_t index);
+    int32_t StartContextLocked(DispatchContext &ctx, size_t index);
+
+    static constexpr size_t CONTEXT_NUM = 2;
+    std::mutex mutex_;
+    std::array<DispatchContext, CONTEXT_NUM> contexts_;
+};
+}
+}
+#endif
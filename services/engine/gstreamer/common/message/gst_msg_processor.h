@@ -17,12 +17,11 @@
 #define GST_MSG_PROCESSOR_H
 
 #include <mutex>
-#include <condition_variable>
 #include <string>
 #include <vector>
 #include <gst/gst.h>
 #include "inner_msg_define.h"
-#include "task_queue.h"
+#include "gst_bus_dispatcher.h"
 #include "gst_msg_converter.h"
 #include "nocopyable.h"
 
@@ -49,21 +48,13 @@ public:
     DISALLOW_COPY_AND_MOVE(GstMsgProcessor);
 
 private:
-    int32_t DoInit();
-    static gboolean MainLoopRunDone(GstMsgProcessor *thiz);
-    static gboolean BusCallback(const GstBus *bus, GstMessage *msg, GstMsgProcessor *thiz);
+    static gboolean BusCallback(GstBus *bus, GstMessage *msg, gpointer data);
     void ProcessGstMessage(GstMessage &msg);
-    void DoReset();
 
     GstBus *gstBus_ = nullptr;
-    GMainLoop *mainLoop_ = nullptr;
-    GMainContext *context_ = nullptr;
-    GSource *busSource_ = 0;
+    GstBusWatch *busWatch_ = nullptr;
     InnerMsgNotifier notifier_;
-    TaskQueue guardTask_;
     std::mutex mutex_;
-    std::condition_variable cond_;
-    bool needWaiting_ = true;
     std::shared_ptr<IGstMsgConverter> msgConverter_;
     std::vector<std::string> filters_;
 };
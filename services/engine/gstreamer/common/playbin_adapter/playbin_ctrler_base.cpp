@@ -95,7 +95,7 @@ int32_t PlayBinCtrlerBase::Init()
     int32_t ret = taskMgr_.Init();
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "task mgr init failed");
 
-    msgQueue_ = std::make_unique<TaskQueue>("playbin-ctrl-msg");
+    msgQueue_ = std::make_unique<TaskQueue>("playbin-ctrl-msg", true);
     ret = msgQueue_->Start();
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "msgqueue start failed");
 
@@ -210,20 +210,98 @@ int32_t PlayBinCtrlerBase::Seek(int64_t timeUs, int32_t seekOption)
 
     std::unique_lock<std::mutex> lock(mutex_);
 
+    bool queued = false;
+    {
+        std::unique_lock<std::mutex> seekLock(seekMutex_);
+        // an accurate seek is never coalesced, the caller expects the exact frame of its own seek.
+        if (seekInFlight_ && !seekQueued_ && seekOption != IPlayBinCtrler::PlayBinSeekMode::CLOSET) {
+            if (pendingSeek_.has_value()) {
+                elidedSeekCount_++;
+            }
+            pendingSeek_ = SeekTarget { timeUs, seekOption };
+            MEDIA_LOGD("seek is in flight, coalesce the seek to %{public}" PRIi64, timeUs);
+            return MSERR_OK;
+        }
+        // this seek is newer than the coalesced one, which is replaced rather than chained before it.
+        if (pendingSeek_.has_value()) {
+            elidedSeekCount_++;
+            pendingSeek_.reset();
+        }
+        queued = seekInFlight_;
+        seekQueued_ = seekQueued_ || queued;
+        seekInFlight_ = true;
+    }
+
+    // the control tasks run ahead of the message reports queued before them
+    ITaskHandler::Attribute attr;
+    attr.priority_ = ITaskHandler::PRIORITY_HIGH;
     auto seekTask = std::make_shared<TaskHandler<void>>([this, timeUs, seekOption]() {
         auto currState = std::static_pointer_cast<BaseState>(GetCurrState());
-        (void)currState->Seek(timeUs, seekOption);
-    });
+        int32_t ret = currState->Seek(timeUs, seekOption);
+        if (ret != MSERR_OK) {
+            // no seek done message will come, the coalesced seek would be rejected in the same state as well.
+            (void)FinishCoalescedSeek();
+            (void)taskMgr_.MarkSecondPhase();
+        }
+    }, attr);
 
     int ret = taskMgr_.LaunchTask(seekTask, PlayBinTaskType::SEEKING);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "Seek failed");
+    if (ret != MSERR_OK) {
+        std::unique_lock<std::mutex> seekLock(seekMutex_);
+        if (queued) {
+            seekQueued_ = false;
+        } else {
+            seekInFlight_ = false;
+        }
+        MEDIA_LOGE("Seek failed");
+        return ret;
+    }
 
     return MSERR_OK;
 }
 
+bool PlayBinCtrlerBase::ContinueCoalescedSeek()
+{
+    SeekTarget target;
+    {
+        std::unique_lock<std::mutex> seekLock(seekMutex_);
+        if (!pendingSeek_.has_value()) {
+            return false;
+        }
+        target = pendingSeek_.value();
+        pendingSeek_.reset();
+    }
+
+    int32_t ret = SeekInternel(target.timeUs, target.option);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, false, "continue the coalesced seek failed");
+    return true;
+}
+
+uint32_t PlayBinCtrlerBase::FinishCoalescedSeek()
+{
+    std::unique_lock<std::mutex> seekLock(seekMutex_);
+    uint32_t elidedCount = elidedSeekCount_;
+    // the queued seek task becomes the one in flight once the task manager launches it.
+    seekInFlight_ = seekQueued_;
+    seekQueued_ = false;
+    pendingSeek_.reset();
+    elidedSeekCount_ = 0;
+    return elidedCount;
+}
+
+void PlayBinCtrlerBase::ResetCoalescedSeek()
+{
+    std::unique_lock<std::mutex> seekLock(seekMutex_);
+    seekInFlight_ = false;
+    seekQueued_ = false;
+    pendingSeek_.reset();
+    elidedSeekCount_ = 0;
+}
+
 int32_t PlayBinCtrlerBase::StopInternel()
 {
     taskMgr_.ClearAllTask();
+    ResetCoalescedSeek();
 
     auto state = GetCurrState();
     if (state == idleState_ || state == stoppedState_ || state == initializedState_) {
@@ -231,10 +309,12 @@ int32_t PlayBinCtrlerBase::StopInternel()
         return MSERR_OK;
     }
 
+    ITaskHandler::Attribute attr;
+    attr.priority_ = ITaskHandler::PRIORITY_HIGH;
     auto stopTask = std::make_shared<TaskHandler<void>>([this]() {
         auto currState = std::static_pointer_cast<BaseState>(GetCurrState());
         (void)currState->Stop();
-    });
+    }, attr);
 
     int ret = taskMgr_.LaunchTask(stopTask, PlayBinTaskType::STATE_CHANGE);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "Stop failed");
@@ -21,6 +21,7 @@
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <optional>
 #include <gst/gst.h>
 #include "nocopyable.h"
 #include "i_playbin_ctrler.h"
@@ -72,6 +73,9 @@ private:
     void ExitInitializedState();
     int32_t PrepareAsyncInternel();
     int32_t SeekInternel(int64_t timeUs, int32_t seekOption);
+    bool ContinueCoalescedSeek();
+    uint32_t FinishCoalescedSeek();
+    void ResetCoalescedSeek();
     int32_t StopInternel();
     void SetupCustomElement();
     int32_t SetupSignalMessage();
@@ -100,6 +104,17 @@ private:
 
     int64_t duration_ = 0;
 
+    struct SeekTarget {
+        int64_t timeUs;
+        int32_t option;
+    };
+    // while a flush seek is in flight, only the latest non-accurate target is kept, the earlier ones are elided.
+    std::mutex seekMutex_;
+    bool seekInFlight_ = false;
+    bool seekQueued_ = false; // a seek task is pending in the task manager behind the one in flight
+    std::optional<SeekTarget> pendingSeek_;
+    uint32_t elidedSeekCount_ = 0;
+
     std::shared_ptr<IdleState> idleState_;
     std::shared_ptr<InitializedState> initializedState_;
     std::shared_ptr<PreparingState> preparingState_;
@@ -26,7 +26,7 @@ namespace Media {
  */
 enum PlayBinMsgType : int32_t {
     PLAYBIN_MSG_ERROR = 0,
-    PLAYBIN_MSG_SEEKDONE = 1,
+    PLAYBIN_MSG_SEEKDONE = 1, // extra: uint32_t, the count of seeks superseded by the later ones
     PLAYBIN_MSG_EOS,
     PLAYBIN_MSG_STATE_CHANGE,
     PLAYBIN_MSG_POSITION_UPDATE,
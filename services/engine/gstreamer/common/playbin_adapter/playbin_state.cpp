@@ -80,6 +80,14 @@ int32_t PlayBinCtrlerBase::BaseState::ChangePlayBinState(GstState targetState)
 
 void PlayBinCtrlerBase::BaseState::OnMessageReceived(const InnerMessage &msg)
 {
+    if ((msg.type == INNER_MSG_STATE_CHANGED) && (msg.detail1 == GST_STATE_PAUSED) &&
+        (msg.detail2 == GST_STATE_PAUSED) && (ctrler_.taskMgr_.GetCurrTaskType() == PlayBinTaskType::SEEKING)) {
+        // chain the coalesced seek within the current seeking task, the states only see the last seek done.
+        if (ctrler_.ContinueCoalescedSeek()) {
+            return;
+        }
+    }
+
     ProcessMessage(msg);
 
     if (msg.type == INNER_MSG_STATE_CHANGED) {
@@ -94,7 +102,11 @@ void PlayBinCtrlerBase::BaseState::OnMessageReceived(const InnerMessage &msg)
 
         if ((msg.detail1 == GST_STATE_PAUSED) && (msg.detail2 == GST_STATE_PAUSED) &&
             (ctrler_.taskMgr_.GetCurrTaskType() == PlayBinTaskType::SEEKING)) {
-            PlayBinMessage playBinMsg { PLAYBIN_MSG_SEEKDONE, 0, 0 };
+            uint32_t elidedCount = ctrler_.FinishCoalescedSeek();
+            if (elidedCount > 0) {
+                MEDIA_LOGI("seek done, %{public}u seeks elided", elidedCount);
+            }
+            PlayBinMessage playBinMsg { PLAYBIN_MSG_SEEKDONE, 0, 0, elidedCount };
             ctrler_.ReportMessage(playBinMsg);
             (void)ctrler_.taskMgr_.MarkSecondPhase();
         }
@@ -23,7 +23,7 @@ namespace {
 
 namespace OHOS {
 namespace Media {
-PlayBinTaskMgr::PlayBinTaskMgr() : taskThread_("playbin_task_mgr")
+PlayBinTaskMgr::PlayBinTaskMgr() : taskThread_("playbin_task_mgr", true)
 {
     MEDIA_LOGD("enter ctor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
 }
@@ -44,16 +44,6 @@ int32_t PlayBinTaskMgr::Init()
     int32_t ret = taskThread_.Start();
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "task thread start failed");
 
-    auto dummyTask = std::make_shared<TaskHandler<void>>([this]() {
-        taskThreadId_ = std::this_thread::get_id();
-    });
-
-    ret = taskThread_.EnqueueTask(dummyTask);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "try get thread id failed");
-
-    auto result = dummyTask->GetResult();
-    CHECK_AND_RETURN_RET_LOG(result.HasResult(), MSERR_INVALID_OPERATION, "try get thread id failed");
-
     isInited_ = true;
 
     return MSERR_OK;
@@ -101,7 +91,7 @@ int32_t PlayBinTaskMgr::MarkSecondPhase()
     std::unique_lock<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(isInited_, MSERR_INVALID_OPERATION, "not init");
 
-    if (std::this_thread::get_id() != taskThreadId_) {
+    if (!taskThread_.IsInTaskThread()) {
         MEDIA_LOGE("not in the task thread, ignored");
         return MSERR_INVALID_OPERATION;
     }
@@ -67,7 +67,6 @@ private:
     PlayBinTaskType currTwoPhaseType_ = PlayBinTaskType::PREEMPT;
     std::list<TwoPhaseTaskItem> pendingTwoPhaseTasks_;
     bool isInited_ = false;
-    std::thread::id taskThreadId_;
     std::mutex mutex_;
 };
 }
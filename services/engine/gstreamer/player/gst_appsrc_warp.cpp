@@ -14,6 +14,7 @@
  */
 
 #include "gst_appsrc_warp.h"
+#include <chrono>
 #include "media_log.h"
 #include "media_errors.h"
 #include "player.h"
@@ -24,10 +25,38 @@ namespace {
     constexpr int32_t BUFFERS_NUM = 5;
     constexpr int32_t BUFFER_SIZE = 81920;
     constexpr int64_t INVALID_SIZE = -1;
+    // one read at a time unless the application opts in, see PLAYER_DATASRC_READ_AHEAD_DEPTH
+    constexpr int32_t DEFAULT_READ_AHEAD_DEPTH = 1;
+    constexpr int32_t MAX_READ_AHEAD_DEPTH = 8;
+    constexpr int32_t MIN_BLOCK_SIZE = 16384;
+    // keep one block within one slot of the media data source shared ring
+    constexpr int32_t MAX_BLOCK_SIZE = 131072;
+    constexpr int32_t BLOCK_ALIGN = 4096;
+    // a block is sized to cover this duration of the measured consume rate
+    constexpr int64_t BLOCK_DURATION_MS = 200;
+    constexpr int64_t CONSUME_WINDOW_US = 1000000;
+    constexpr int64_t US_PER_S = 1000000;
+    constexpr int64_t MS_PER_S = 1000;
+    constexpr int32_t RATE_SMOOTH_FACTOR = 4;
+    // at most this share of the mems may be held downstream, above it the data is copied
+    constexpr int32_t WRAP_HELD_DIVISOR = 2;
+    // a buffer with GST_BUFFER_MEM_MAX memories merges them into a copy when one more is appended
+    constexpr guint MAX_WRAPPED_MEMS = GST_BUFFER_MEM_MAX - 1;
+
+    int64_t GetCurrentTimeUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 }
 
 namespace OHOS {
 namespace Media {
+struct AppsrcWrappedMem {
+    std::weak_ptr<GstAppsrcWarp> warp;
+    std::shared_ptr<AppsrcMemWarp> appSrcMem;
+};
+
 std::shared_ptr<GstAppsrcWarp> GstAppsrcWarp::Create(const std::shared_ptr<IMediaDataSource> &dataSrc)
 {
     CHECK_AND_RETURN_RET_LOG(dataSrc != nullptr, nullptr, "input dataSrc is empty!");
@@ -43,13 +72,18 @@ std::shared_ptr<GstAppsrcWarp> GstAppsrcWarp::Create(const std::shared_ptr<IMedi
 GstAppsrcWarp::GstAppsrcWarp(const std::shared_ptr<IMediaDataSource> &dataSrc, const int64_t size)
     : dataSrc_(dataSrc),
       size_(size),
-      fillTaskQue_("fillbufferTask"),
       emptyTaskQue_("emptybufferTask"),
-      bufferSize_(BUFFER_SIZE),
-      buffersNum_(BUFFERS_NUM)
+      bufferSize_(MAX_BLOCK_SIZE),
+      buffersNum_(0),
+      readAheadDepth_(DEFAULT_READ_AHEAD_DEPTH),
+      blockSize_(BUFFER_SIZE)
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create and size %{public}" PRId64 "", FAKE_POINTER(this), size);
     streamType_ = size == INVALID_SIZE ? GST_APP_STREAM_TYPE_STREAM : GST_APP_STREAM_TYPE_RANDOM_ACCESS;
+    if (streamType_ != GST_APP_STREAM_TYPE_STREAM) {
+        cache_ = std::make_shared<MediaDataSourceCache>(dataSrc, size);
+        dataSrc_ = cache_;
+    }
 }
 
 GstAppsrcWarp::~GstAppsrcWarp()
@@ -61,7 +95,13 @@ GstAppsrcWarp::~GstAppsrcWarp()
 
 int32_t GstAppsrcWarp::Init()
 {
-    for (int i = 0; i < buffersNum_; ++i) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return AllocBuffers(BUFFERS_NUM + readAheadDepth_);
+}
+
+int32_t GstAppsrcWarp::AllocBuffers(int32_t num)
+{
+    for (; buffersNum_ < num; ++buffersNum_) {
         std::shared_ptr<AppsrcMemWarp> appSrcMem = std::make_shared<AppsrcMemWarp>();
         CHECK_AND_RETURN_RET_LOG(appSrcMem != nullptr, MSERR_NO_MEMORY, "init AppsrcMemWarp failed");
         appSrcMem->mem = AVSharedMemory::Create(bufferSize_, AVSharedMemory::Flags::FLAGS_READ_WRITE, "appsrc");
@@ -71,6 +111,42 @@ int32_t GstAppsrcWarp::Init()
     return MSERR_OK;
 }
 
+int32_t GstAppsrcWarp::SetParameter(const Format &param)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(isExit_, MSERR_INVALID_OPERATION, "the read-ahead can only be set before prepare");
+
+    int32_t depth = 0;
+    if (param.GetIntValue(PLAYER_DATASRC_READ_AHEAD_DEPTH, depth)) {
+        CHECK_AND_RETURN_RET_LOG(depth > 0 && depth <= MAX_READ_AHEAD_DEPTH, MSERR_INVALID_VAL,
+            "invalid read-ahead depth %{public}d", depth);
+        if (streamType_ == GST_APP_STREAM_TYPE_STREAM) {
+            MEDIA_LOGW("stream data source only support one read in flight");
+        } else {
+            readAheadDepth_ = depth;
+        }
+    }
+
+    int32_t blockSize = 0;
+    if (param.GetIntValue(PLAYER_DATASRC_BLOCK_SIZE, blockSize)) {
+        CHECK_AND_RETURN_RET_LOG(blockSize == 0 || (blockSize >= MIN_BLOCK_SIZE && blockSize <= MAX_BLOCK_SIZE),
+            MSERR_INVALID_VAL, "invalid block size %{public}d", blockSize);
+        fixedBlockSize_ = blockSize;
+        blockSize_ = blockSize > 0 ? blockSize : BUFFER_SIZE;
+    }
+
+    int32_t cacheSize = 0;
+    if (param.GetIntValue(PLAYER_DATASRC_CACHE_SIZE, cacheSize)) {
+        CHECK_AND_RETURN_RET_LOG(cacheSize >= 0, MSERR_INVALID_VAL, "invalid cache size %{public}d", cacheSize);
+        if (cache_ != nullptr) {
+            cache_->SetCapacity(cacheSize);
+        }
+    }
+
+    MEDIA_LOGI("read-ahead depth %{public}d, block size %{public}d", readAheadDepth_, fixedBlockSize_);
+    return AllocBuffers(BUFFERS_NUM + readAheadDepth_);
+}
+
 int32_t GstAppsrcWarp::Prepare()
 {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -85,19 +161,35 @@ int32_t GstAppsrcWarp::Prepare()
     needDataSize_ = 0;
     atEos_ = false;
     curPos_ = 0;
+    issuedEnd_ = 0;
+    readGeneration_++;
+    consumeBytes_ = 0;
+    consumeStartUs_ = 0;
     while (!filledBuffers_.empty()) {
         std::shared_ptr<AppsrcMemWarp> appSrcMem = filledBuffers_.front();
         filledBuffers_.pop();
-        emptyBuffers_.push(appSrcMem);
+        RecycleMemLocked(appSrcMem);
+    }
+    while (!inflightBuffers_.empty()) {
+        emptyBuffers_.push(inflightBuffers_.front());
+        inflightBuffers_.pop_front();
+    }
+    fillTaskQues_.clear();
+    for (int32_t i = 0; i < readAheadDepth_; ++i) {
+        auto fillTaskQue = std::make_unique<TaskQueue>("fillbufferTask" + std::to_string(i));
+        CHECK_AND_RETURN_RET_LOG(fillTaskQue->Start() == MSERR_OK, MSERR_INVALID_OPERATION, "init task failed");
+        // the fill task is bulk work, it yields to any control task queued with it
+        ITaskHandler::Attribute attr;
+        attr.priority_ = ITaskHandler::PRIORITY_LOW;
+        auto task = std::make_shared<TaskHandler<void>>([this] {
+            FillTask();
+        }, attr);
+        CHECK_AND_RETURN_RET_LOG(fillTaskQue->EnqueueTask(task) == MSERR_OK,
+            MSERR_INVALID_OPERATION, "enque task failed");
+        fillTaskQues_.push_back(std::move(fillTaskQue));
     }
-    CHECK_AND_RETURN_RET_LOG(fillTaskQue_.Start() == MSERR_OK, MSERR_INVALID_OPERATION, "init task failed");
     CHECK_AND_RETURN_RET_LOG(emptyTaskQue_.Start() == MSERR_OK, MSERR_INVALID_OPERATION, "init task failed");
     auto task = std::make_shared<TaskHandler<void>>([this] {
-        FillTask();
-    });
-    CHECK_AND_RETURN_RET_LOG(fillTaskQue_.EnqueueTask(task) == MSERR_OK,
-        MSERR_INVALID_OPERATION, "enque task failed");
-    task = std::make_shared<TaskHandler<void>>([this] {
         EmptyTask();
     });
     CHECK_AND_RETURN_RET_LOG(emptyTaskQue_.EnqueueTask(task) == MSERR_OK,
@@ -108,18 +200,26 @@ int32_t GstAppsrcWarp::Prepare()
 
 void GstAppsrcWarp::Stop()
 {
+    GstBuffer *buffer = nullptr;
     {
         std::unique_lock<std::mutex> lock(mutex_);
         isExit_ = true;
         if (bufferWarp_ != nullptr) {
-            gst_buffer_unref(bufferWarp_->buffer);
+            buffer = bufferWarp_->buffer;
             bufferWarp_ = nullptr;
         }
         fillCond_.notify_all();
         emptyCond_.notify_all();
     }
-    (void)fillTaskQue_.Stop();
+    // the wrapped mems take mutex_ when they are freed
+    if (buffer != nullptr) {
+        gst_buffer_unref(buffer);
+    }
+    for (auto &fillTaskQue : fillTaskQues_) {
+        (void)fillTaskQue->Stop();
+    }
     (void)emptyTaskQue_.Stop();
+    ReportCacheStatistics();
 }
 
 void GstAppsrcWarp::ClearAppsrc()
@@ -182,12 +282,13 @@ void GstAppsrcWarp::NeedData(const GstElement *appSrc, uint32_t size, gpointer s
 
 void GstAppsrcWarp::NeedDataInner(uint32_t size)
 {
+    std::unique_lock<std::mutex> pushLock(pushMutex_);
     std::unique_lock<std::mutex> lock(mutex_);
     int32_t ret = MSERR_OK;
     needDataSize_ = static_cast<int32_t>(size);
     if (!filledBuffers_.empty() && (needDataSize_ <= filledBufferSize_ || atEos_ ||
         streamType_ == GST_APP_STREAM_TYPE_STREAM) && !isExit_) {
-        ret = GetAndPushMem();
+        ret = GetAndPushMem(lock);
         if (ret != MSERR_OK) {
             OnError(ret);
         }
@@ -211,14 +312,25 @@ void GstAppsrcWarp::EmptyTask()
 {
     int32_t ret = MSERR_OK;
     while (ret == MSERR_OK) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            emptyCond_.wait(lock, [this] {
+                return (!filledBuffers_.empty() && needData_) || isExit_;
+            });
+            if (isExit_) {
+                break;
+            }
+        }
+        // take the locks again in order, the data may have been pushed by NeedDataInner meanwhile.
+        std::unique_lock<std::mutex> pushLock(pushMutex_);
         std::unique_lock<std::mutex> lock(mutex_);
-        emptyCond_.wait(lock, [this] {
-            return (!filledBuffers_.empty() && needData_) || isExit_;
-        });
         if (isExit_) {
             break;
         }
-        ret = GetAndPushMem();
+        if (filledBuffers_.empty() || !needData_) {
+            continue;
+        }
+        ret = GetAndPushMem(lock);
     }
     if (ret != MSERR_OK) {
         OnError(ret);
@@ -241,7 +353,7 @@ void GstAppsrcWarp::SeekAndFreeBuffers(uint64_t pos)
         std::shared_ptr<AppsrcMemWarp> appSrcMem = filledBuffers_.front();
         if (appSrcMem->size < 0) {
             filledBuffers_.pop();
-            emptyBuffers_.push(appSrcMem);
+            RecycleMemLocked(appSrcMem);
             continue;
         }
         if (appSrcMem->pos <= pos && appSrcMem->pos + static_cast<uint64_t>(appSrcMem->size) > pos) {
@@ -253,10 +365,10 @@ void GstAppsrcWarp::SeekAndFreeBuffers(uint64_t pos)
         }
         filledBufferSize_ = filledBufferSize_ - (appSrcMem->size - appSrcMem->offset);
         filledBuffers_.pop();
-        emptyBuffers_.push(appSrcMem);
+        RecycleMemLocked(appSrcMem);
     }
     if (filledBuffers_.empty()) {
-        curPos_ = pos;
+        InvalidateReadsLocked(pos);
         atEos_ = false;
     }
     fillCond_.notify_all();
@@ -282,40 +394,127 @@ int32_t GstAppsrcWarp::ReadAndGetMem()
             }
             appSrcMem = emptyBuffers_.front();
             CHECK_AND_RETURN_RET_LOG(appSrcMem != nullptr && appSrcMem->mem != nullptr, MSERR_NO_MEMORY, "no mem");
-            appSrcMem->pos = curPos_;
             emptyBuffers_.pop();
+            appSrcMem->pos = curPos_;
+            appSrcMem->readSize = std::min(blockSize_, appSrcMem->mem->GetSize());
+            appSrcMem->generation = readGeneration_;
+            appSrcMem->sequential = appSrcMem->pos == issuedEnd_;
+            appSrcMem->filled = false;
+            appSrcMem->refs = 0;
+            appSrcMem->consumed = false;
+            // the next read in flight starts right after this one
+            curPos_ = curPos_ + static_cast<uint64_t>(appSrcMem->readSize);
+            issuedEnd_ = curPos_;
+            inflightBuffers_.push_back(appSrcMem);
         }
+        int64_t startUs = GetCurrentTimeUs();
         if (size_ == INVALID_SIZE) {
-            size = dataSrc_->ReadAt(bufferSize_, appSrcMem->mem);
+            size = dataSrc_->ReadAt(static_cast<uint32_t>(appSrcMem->readSize), appSrcMem->mem);
+        } else if (cache_ != nullptr) {
+            size = cache_->ReadAt(static_cast<int64_t>(appSrcMem->pos),
+                static_cast<uint32_t>(appSrcMem->readSize), appSrcMem->mem, appSrcMem->sequential);
         } else {
-            size = dataSrc_->ReadAt(static_cast<int64_t>(appSrcMem->pos), bufferSize_, appSrcMem->mem);
+            size = dataSrc_->ReadAt(static_cast<int64_t>(appSrcMem->pos),
+                static_cast<uint32_t>(appSrcMem->readSize), appSrcMem->mem);
         }
+        int64_t costUs = GetCurrentTimeUs() - startUs;
         if (size > appSrcMem->mem->GetSize()) {
             ret = MSERR_INVALID_VAL;
         }
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            if (size == 0 || curPos_ != appSrcMem->pos) {
-                emptyBuffers_.push(appSrcMem);
-            } else if (size < 0) {
-                appSrcMem->size = size;
-                atEos_ = true;
-                filledBuffers_.push(appSrcMem);
-            } else {
-                size = std::min(size, appSrcMem->mem->GetSize());
-                appSrcMem->size = size;
-                filledBufferSize_ += size;
-                appSrcMem->pos = curPos_;
-                appSrcMem->offset = 0;
-                curPos_ = curPos_ + static_cast<uint64_t>(size);
-                filledBuffers_.push(appSrcMem);
-            }
+            appSrcMem->size = size;
+            appSrcMem->filled = true;
+            UpdateBlockSizeLocked(size, costUs);
+            CommitReadsLocked();
             emptyCond_.notify_all();
         }
     }
     return ret;
 }
 
+void GstAppsrcWarp::CommitReadsLocked()
+{
+    // reads may complete out of order, only the completed head of the in-flight list is delivered.
+    while (!inflightBuffers_.empty() && inflightBuffers_.front()->filled) {
+        std::shared_ptr<AppsrcMemWarp> appSrcMem = inflightBuffers_.front();
+        inflightBuffers_.pop_front();
+        if (appSrcMem->generation != readGeneration_) {
+            emptyBuffers_.push(appSrcMem);
+            fillCond_.notify_all();
+            continue;
+        }
+        int32_t size = appSrcMem->size;
+        if (size == 0) {
+            emptyBuffers_.push(appSrcMem);
+            InvalidateReadsLocked(appSrcMem->pos);
+        } else if (size < 0) {
+            atEos_ = true;
+            filledBuffers_.push(appSrcMem);
+            InvalidateReadsLocked(appSrcMem->pos);
+        } else {
+            size = std::min(size, appSrcMem->mem->GetSize());
+            appSrcMem->size = size;
+            appSrcMem->offset = 0;
+            filledBufferSize_ += size;
+            filledBuffers_.push(appSrcMem);
+            if (size < appSrcMem->readSize) {
+                // short read, the reads issued behind this one start at the wrong position
+                InvalidateReadsLocked(appSrcMem->pos + static_cast<uint64_t>(size));
+            }
+        }
+    }
+}
+
+void GstAppsrcWarp::InvalidateReadsLocked(uint64_t pos)
+{
+    readGeneration_++;
+    curPos_ = pos;
+    fillCond_.notify_all();
+}
+
+void GstAppsrcWarp::UpdateBlockSizeLocked(int32_t size, int64_t costUs)
+{
+    if (fixedBlockSize_ > 0 || size <= 0 || costUs <= 0) {
+        return;
+    }
+
+    int64_t rate = static_cast<int64_t>(size) * US_PER_S / costUs;
+    readRate_ = readRate_ == 0 ? rate : (readRate_ * (RATE_SMOOTH_FACTOR - 1) + rate) / RATE_SMOOTH_FACTOR;
+    if (consumeRate_ == 0) {
+        return;
+    }
+
+    int64_t target = consumeRate_ * BLOCK_DURATION_MS / MS_PER_S;
+    if (readRate_ < consumeRate_ * readAheadDepth_) {
+        // the data source is slow for the bitrate, make the blocks larger to save round trips
+        target *= readAheadDepth_;
+    }
+    target = (target + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+    target = std::max(target, static_cast<int64_t>(MIN_BLOCK_SIZE));
+    target = std::min(target, static_cast<int64_t>(MAX_BLOCK_SIZE));
+    if (target != blockSize_) {
+        MEDIA_LOGD("block size %{public}d -> %{public}" PRId64 ", read rate %{public}" PRId64
+            ", consume rate %{public}" PRId64, blockSize_, target, readRate_, consumeRate_);
+        blockSize_ = static_cast<int32_t>(target);
+    }
+}
+
+void GstAppsrcWarp::UpdateConsumeRateLocked(int32_t size)
+{
+    int64_t nowUs = GetCurrentTimeUs();
+    if (consumeStartUs_ == 0) {
+        consumeStartUs_ = nowUs;
+    }
+    consumeBytes_ += size;
+    int64_t elapsedUs = nowUs - consumeStartUs_;
+    if (elapsedUs >= CONSUME_WINDOW_US) {
+        consumeRate_ = consumeBytes_ * US_PER_S / elapsedUs;
+        consumeBytes_ = 0;
+        consumeStartUs_ = nowUs;
+    }
+}
+
 void GstAppsrcWarp::EosAndCheckSize(int32_t size)
 {
     MEDIA_LOGD("%{public}d", size);
@@ -334,16 +533,22 @@ void GstAppsrcWarp::EosAndCheckSize(int32_t size)
     }
 }
 
-int32_t GstAppsrcWarp::GetAndPushMem()
+// called with pushMutex_ and mutex_ held, mutex_ is released while emitting the appsrc signals and while
+// dropping a buffer: appsrc holds its own lock when it drops the queued buffers, and the wrapped memories
+// take mutex_ when they are freed.
+int32_t GstAppsrcWarp::GetAndPushMem(std::unique_lock<std::mutex> &lock)
 {
     int32_t size = needDataSize_ > filledBufferSize_ ? filledBufferSize_ : needDataSize_;
     std::shared_ptr<AppsrcMemWarp> appSrcMem = filledBuffers_.front();
     CHECK_AND_RETURN_RET_LOG(appSrcMem != nullptr && appSrcMem->mem != nullptr, MSERR_NO_MEMORY, "no mem");
     if (size == 0) {
-        EosAndCheckSize(appSrcMem->size);
+        int32_t eosSize = appSrcMem->size;
         filledBuffers_.pop();
-        emptyBuffers_.push(appSrcMem);
+        RecycleMemLocked(appSrcMem);
         needData_ = false;
+        lock.unlock();
+        EosAndCheckSize(eosSize);
+        lock.lock();
         return MSERR_OK;
     }
     GstBuffer *buffer = nullptr;
@@ -352,36 +557,60 @@ int32_t GstAppsrcWarp::GetAndPushMem()
     } else {
         bufferWarp_ = std::make_shared<AppsrcBufferWarp>();
         int32_t allocSize = streamType_ == GST_APP_STREAM_TYPE_STREAM ? size : needDataSize_;
-        buffer = gst_buffer_new_allocate(nullptr, static_cast<gsize>(allocSize), nullptr);
-        CHECK_AND_RETURN_RET_LOG(buffer != nullptr, MSERR_NO_MEMORY, "no mem");
+        // wrap the mems while enough of them are left for the reads, otherwise copy so the reads never starve
+        bufferWarp_->wrapped = heldBuffersNum_ < buffersNum_ / WRAP_HELD_DIVISOR;
+        if (bufferWarp_->wrapped) {
+            buffer = gst_buffer_new();
+        } else {
+            buffer = gst_buffer_new_allocate(nullptr, static_cast<gsize>(allocSize), nullptr);
+        }
+        if (buffer == nullptr) {
+            bufferWarp_ = nullptr;
+            MEDIA_LOGE("no mem");
+            return MSERR_NO_MEMORY;
+        }
         GST_BUFFER_OFFSET(buffer) = appSrcMem->pos + appSrcMem->offset;
         bufferWarp_->buffer = buffer;
         bufferWarp_->offset = 0;
         bufferWarp_->size = allocSize;
     }
-    GstMapInfo info = GST_MAP_INFO_INIT;
-    if (gst_buffer_map(buffer, &info, GST_MAP_WRITE) == FALSE) {
-        gst_buffer_unref(buffer);
-        MEDIA_LOGE("map buffer failed");
-        return MSERR_NO_MEMORY;
+    int32_t startOffset = bufferWarp_->offset;
+    bool fillRet = false;
+    if (bufferWarp_->wrapped) {
+        fillRet = WrapToGstBuffer(buffer);
+    } else {
+        GstMapInfo info = GST_MAP_INFO_INIT;
+        if (gst_buffer_map(buffer, &info, GST_MAP_WRITE) == FALSE) {
+            bufferWarp_ = nullptr;
+            MEDIA_LOGE("map buffer failed");
+            UnrefBufferUnlocked(lock, buffer);
+            return MSERR_NO_MEMORY;
+        }
+        fillRet = CopyToGstBuffer(info);
+        gst_buffer_unmap(buffer, &info);
     }
-    bool copyRet = CopyToGstBuffer(info);
-    gst_buffer_unmap(buffer, &info);
-    if (!copyRet) {
-        MEDIA_LOGE("copy buffer failed");
-        gst_buffer_unref(buffer);
+    if (!fillRet) {
+        MEDIA_LOGE("fill buffer failed");
+        bufferWarp_ = nullptr;
+        UnrefBufferUnlocked(lock, buffer);
         return MSERR_NO_MEMORY;
     }
-    if (bufferWarp_->size == bufferWarp_->offset) {
-        bufferWarp_ = nullptr;
-        PushData(buffer);
-        needDataSize_ = 0;
-        needData_ = false;
-        gst_buffer_unref(buffer);
-    } else {
+    // less than size is taken if the wrapped buffer is full of memories
+    int32_t filledSize = bufferWarp_->offset - startOffset;
+    filledBufferSize_ -= filledSize;
+    UpdateConsumeRateLocked(filledSize);
+    if (bufferWarp_->size != bufferWarp_->offset) {
         needDataSize_ = bufferWarp_->size - bufferWarp_->offset;
+        return MSERR_OK;
     }
-    filledBufferSize_ -= size;
+
+    bufferWarp_ = nullptr;
+    needDataSize_ = 0;
+    needData_ = false;
+    lock.unlock();
+    PushData(buffer);
+    gst_buffer_unref(buffer);
+    lock.lock();
     return MSERR_OK;
 }
 
@@ -402,8 +631,7 @@ bool GstAppsrcWarp::CopyToGstBuffer(const GstMapInfo &info)
             "get mem is nullptr");
         if (lastSize <= size) {
             filledBuffers_.pop();
-            emptyBuffers_.push(appSrcMem);
-            fillCond_.notify_all();
+            RecycleMemLocked(appSrcMem);
         } else {
             appSrcMem->offset += copySize;
         }
@@ -417,6 +645,94 @@ bool GstAppsrcWarp::CopyToGstBuffer(const GstMapInfo &info)
     return true;
 }
 
+bool GstAppsrcWarp::WrapToGstBuffer(GstBuffer *buffer)
+{
+    int32_t size = bufferWarp_->size - bufferWarp_->offset;
+    while (size > 0 && !filledBuffers_.empty()) {
+        if (gst_buffer_n_memory(buffer) >= MAX_WRAPPED_MEMS) {
+            // push what is wrapped so far, the rest goes to the next buffer
+            bufferWarp_->size = bufferWarp_->offset;
+            return true;
+        }
+        std::shared_ptr<AppsrcMemWarp> appSrcMem = filledBuffers_.front();
+        CHECK_AND_BREAK_LOG(appSrcMem != nullptr && appSrcMem->mem != nullptr
+            && appSrcMem->mem->GetBase() != nullptr
+            && (appSrcMem->size - appSrcMem->offset) > 0,
+            "get mem is nullptr");
+        int32_t lastSize = appSrcMem->size - appSrcMem->offset;
+        int32_t wrapSize = std::min(lastSize, size);
+        AppsrcWrappedMem *wrappedMem = new(std::nothrow) AppsrcWrappedMem { weak_from_this(), appSrcMem };
+        CHECK_AND_BREAK_LOG(wrappedMem != nullptr, "new wrapped mem failed");
+        GstMemory *memory = gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY, appSrcMem->mem->GetBase(),
+            static_cast<gsize>(appSrcMem->mem->GetSize()), static_cast<gsize>(appSrcMem->offset),
+            static_cast<gsize>(wrapSize), wrappedMem, WrappedMemDestroyNotify);
+        if (memory == nullptr) {
+            delete wrappedMem;
+            MEDIA_LOGE("wrap mem failed");
+            break;
+        }
+        if (appSrcMem->refs++ == 0) {
+            heldBuffersNum_++;
+        }
+        gst_buffer_append_memory(buffer, memory);
+        if (lastSize <= size) {
+            filledBuffers_.pop();
+            RecycleMemLocked(appSrcMem);
+        } else {
+            appSrcMem->offset += wrapSize;
+        }
+        bufferWarp_->offset += wrapSize;
+        size -= wrapSize;
+    }
+    if (size != 0 && !filledBuffers_.empty()) {
+        return false;
+    }
+    return true;
+}
+
+void GstAppsrcWarp::RecycleMemLocked(const std::shared_ptr<AppsrcMemWarp> &appSrcMem)
+{
+    appSrcMem->consumed = true;
+    if (appSrcMem->refs > 0) {
+        // still referenced downstream, it comes back when the last wrapped memory is freed
+        return;
+    }
+    emptyBuffers_.push(appSrcMem);
+    fillCond_.notify_all();
+}
+
+void GstAppsrcWarp::ReleaseWrappedMem(const std::shared_ptr<AppsrcMemWarp> &appSrcMem)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (--appSrcMem->refs > 0) {
+        return;
+    }
+    heldBuffersNum_--;
+    if (appSrcMem->consumed) {
+        emptyBuffers_.push(appSrcMem);
+        fillCond_.notify_all();
+    }
+}
+
+void GstAppsrcWarp::UnrefBufferUnlocked(std::unique_lock<std::mutex> &lock, GstBuffer *buffer)
+{
+    // never drop a buffer with mutex_ held, its wrapped mems take mutex_ when they are freed
+    lock.unlock();
+    gst_buffer_unref(buffer);
+    lock.lock();
+}
+
+void GstAppsrcWarp::WrappedMemDestroyNotify(gpointer userData)
+{
+    AppsrcWrappedMem *wrappedMem = static_cast<AppsrcWrappedMem *>(userData);
+    CHECK_AND_RETURN_LOG(wrappedMem != nullptr, "wrapped mem is nullptr");
+    std::shared_ptr<GstAppsrcWarp> warp = wrappedMem->warp.lock();
+    if (warp != nullptr) {
+        warp->ReleaseWrappedMem(wrappedMem->appSrcMem);
+    }
+    delete wrappedMem;
+}
+
 void GstAppsrcWarp::OnError(int32_t errorCode)
 {
     PlayerErrorType errorType = PLAYER_ERROR_UNKNOWN;
@@ -426,6 +742,27 @@ void GstAppsrcWarp::OnError(int32_t errorCode)
     }
 }
 
+void GstAppsrcWarp::ReportCacheStatistics()
+{
+    if (cache_ == nullptr) {
+        return;
+    }
+    cache_->DumpStatistics();
+    MediaDataSourceCache::Statistics stats = cache_->GetStatistics();
+    if (stats.hitCount == 0 && stats.missCount == 0) {
+        return;
+    }
+    Format format;
+    (void)format.PutLongValue(PLAYER_DATASRC_CACHE_HITS, static_cast<int64_t>(stats.hitCount));
+    (void)format.PutLongValue(PLAYER_DATASRC_CACHE_MISSES, static_cast<int64_t>(stats.missCount));
+    (void)format.PutLongValue(PLAYER_DATASRC_CACHE_HIT_BYTES, static_cast<int64_t>(stats.hitBytes));
+    (void)format.PutLongValue(PLAYER_DATASRC_CACHE_MISS_BYTES, static_cast<int64_t>(stats.missBytes));
+    std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
+    if (tempObs != nullptr) {
+        tempObs->OnInfo(INFO_TYPE_EXTRA_FORMAT, 0, format);
+    }
+}
+
 void GstAppsrcWarp::PushData(const GstBuffer *buffer) const
 {
     int32_t ret = GST_FLOW_OK;
@@ -17,9 +17,11 @@
 #define GST_APPSRC_WARP_H_
 
 #include <gst/gst.h>
+#include <deque>
 #include <queue>
 #include "task_queue.h"
 #include "media_data_source.h"
+#include "media_data_source_cache.h"
 #include "gst/app/gstappsrc.h"
 #include "i_player_engine.h"
 #include "nocopyable.h"
@@ -34,15 +36,29 @@ struct AppsrcMemWarp {
     int32_t size;
     // offset of mem
     int32_t offset;
+    // size requested from the data source
+    int32_t readSize;
+    // read generation, a seek or a short read makes the reads in flight stale
+    uint64_t generation;
+    // the read continues the previous one issued, as opposed to the first read after a seek
+    bool sequential;
+    // the read has completed
+    bool filled;
+    // number of wrapped GstMemory still referencing this mem downstream
+    int32_t refs;
+    // all data of this mem has been handed to appsrc
+    bool consumed;
 };
 
 struct AppsrcBufferWarp {
     GstBuffer *buffer = nullptr;
     int32_t offset = 0;
     int32_t size = 0;
+    // the buffer references the mems directly instead of holding a copy
+    bool wrapped = false;
 };
 
-class GstAppsrcWarp {
+class GstAppsrcWarp : public std::enable_shared_from_this<GstAppsrcWarp> {
 public:
     static std::shared_ptr<GstAppsrcWarp> Create(const std::shared_ptr<IMediaDataSource> &dataSrc);
     GstAppsrcWarp(const std::shared_ptr<IMediaDataSource> &dataSrc, const int64_t size);
@@ -50,6 +66,7 @@ public:
     DISALLOW_COPY_AND_MOVE(GstAppsrcWarp);
     int32_t SetAppsrc(GstElement *appSrc);
     int32_t SetErrorCallback(const std::weak_ptr<IPlayerEngineObs> &obs);
+    int32_t SetParameter(const Format &param);
     bool IsLiveMode() const;
     int32_t Init();
     int32_t Prepare();
@@ -64,29 +81,46 @@ private:
     gboolean SeekDataInner(uint64_t seekPos);
     void SeekAndFreeBuffers(uint64_t pos);
     int32_t ReadAndGetMem();
+    int32_t AllocBuffers(int32_t num);
+    void CommitReadsLocked();
+    void InvalidateReadsLocked(uint64_t pos);
+    void UpdateBlockSizeLocked(int32_t size, int64_t costUs);
+    void UpdateConsumeRateLocked(int32_t size);
     void AnalyzeSize(int32_t size);
-    int32_t GetAndPushMem();
+    int32_t GetAndPushMem(std::unique_lock<std::mutex> &lock);
     void OnError(int32_t errorCode);
+    void ReportCacheStatistics();
     void PushData(const GstBuffer *buffer) const;
     void PushEos();
     void FillTask();
     void EmptyTask();
     void EosAndCheckSize(int32_t size);
     bool CopyToGstBuffer(const GstMapInfo &info);
+    bool WrapToGstBuffer(GstBuffer *buffer);
+    void RecycleMemLocked(const std::shared_ptr<AppsrcMemWarp> &appSrcMem);
+    void ReleaseWrappedMem(const std::shared_ptr<AppsrcMemWarp> &appSrcMem);
+    void UnrefBufferUnlocked(std::unique_lock<std::mutex> &lock, GstBuffer *buffer);
+    static void WrappedMemDestroyNotify(gpointer userData);
     std::shared_ptr<IMediaDataSource> dataSrc_ = nullptr;
+    std::shared_ptr<MediaDataSourceCache> cache_ = nullptr;
     const int64_t size_;
     uint64_t curPos_ = 0;
+    // end of the last read issued, the reads are issued in file order under mutex_ even if they run concurrently
+    uint64_t issuedEnd_ = 0;
     std::mutex mutex_;
+    // serializes the pushes to appsrc, which are emitted with mutex_ released. Lock order: pushMutex_, mutex_.
+    std::mutex pushMutex_;
     std::condition_variable emptyCond_;
     std::condition_variable fillCond_;
     GstElement *appSrc_ = nullptr;
-    TaskQueue fillTaskQue_;
+    std::vector<std::unique_ptr<TaskQueue>> fillTaskQues_;
     TaskQueue emptyTaskQue_;
     GstAppStreamType streamType_ = GST_APP_STREAM_TYPE_STREAM;
     std::weak_ptr<IPlayerEngineObs> obs_;
     std::vector<gulong> callbackIds_;
     std::queue<std::shared_ptr<AppsrcMemWarp>> emptyBuffers_;
     std::queue<std::shared_ptr<AppsrcMemWarp>> filledBuffers_;
+    std::deque<std::shared_ptr<AppsrcMemWarp>> inflightBuffers_;
     bool atEos_ = false;
     bool needData_ = false;
     int32_t needDataSize_ = 0;
@@ -94,6 +128,15 @@ private:
     int32_t filledBufferSize_ = 0;
     int32_t bufferSize_;
     int32_t buffersNum_;
+    int32_t readAheadDepth_;
+    int32_t fixedBlockSize_ = 0;
+    int32_t blockSize_;
+    uint64_t readGeneration_ = 0;
+    int64_t readRate_ = 0;
+    int64_t consumeRate_ = 0;
+    int64_t consumeBytes_ = 0;
+    int64_t consumeStartUs_ = 0;
+    int32_t heldBuffersNum_ = 0;
     std::shared_ptr<AppsrcBufferWarp> bufferWarp_;
 };
 } // namespace Media
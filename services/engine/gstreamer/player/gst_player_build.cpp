@@ -104,29 +104,47 @@ std::shared_ptr<GstPlayerCtrl> GstPlayerBuild::Build(sptr<Surface> surface)
         MEDIA_LOGE("gstPlayer_ or playerCtrl_ is nullptr");
         return nullptr;
     }
+    playerCtrl_->SetVideoRendererCtrl(rendererCtrl_);
 
     return playerCtrl_;
 }
 
+void GstPlayerBuild::SetSurface(const sptr<Surface> &surface)
+{
+    CHECK_AND_RETURN_LOG(rendererCtrl_ != nullptr, "rendererCtrl_ is nullptr");
+    (void)rendererCtrl_->SetSurface(surface);
+}
+
 void GstPlayerBuild::CreateLoop()
 {
     MEDIA_LOGI("Create the loop for the current context");
     CHECK_AND_RETURN_LOG(context_ != nullptr, "context_ is nullptr");
 
-    loop_ = g_main_loop_new(context_, FALSE);
-    CHECK_AND_RETURN_LOG(loop_ != nullptr, "gstPlayer_ is nullptr");
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        CHECK_AND_RETURN_LOG(!quit_, "the loop is destroyed already");
+        loop_ = g_main_loop_new(context_, FALSE);
+        CHECK_AND_RETURN_LOG(loop_ != nullptr, "gstPlayer_ is nullptr");
+    }
 
     GSource *source = g_idle_source_new();
     g_source_set_callback(source, (GSourceFunc)GstPlayerBuild::MainLoopRunCb, this,
         nullptr);
     guint ret = g_source_attach(source, context_);
-    CHECK_AND_RETURN_LOG(ret > 0, "add idle source failed");
     g_source_unref(source);
+    if (ret > 0) {
+        g_main_loop_run(loop_);
+        // wait g_main_loop_quit
+    } else {
+        MEDIA_LOGE("add idle source failed");
+    }
 
-    g_main_loop_run(loop_);
-    // wait g_main_loop_quit
+    std::unique_lock<std::mutex> lock(mutex_);
     g_main_loop_unref(loop_);
     loop_ = nullptr;
+    // the loop may have never run, do not leave WaitMainLoopStart waiting
+    needWaiting_ = false;
+    cond_.notify_all();
 }
 
 gboolean GstPlayerBuild::MainLoopRunCb(GstPlayerBuild *build)
@@ -136,6 +154,10 @@ gboolean GstPlayerBuild::MainLoopRunCb(GstPlayerBuild *build)
     }
 
     std::unique_lock<std::mutex> lock(build->mutex_);
+    if (build->quit_) {
+        // the quit came before the loop was running, it would be lost
+        g_main_loop_quit(build->loop_);
+    }
     build->needWaiting_ = false;
     build->cond_.notify_one();
 
@@ -148,8 +170,10 @@ void GstPlayerBuild::WaitMainLoopStart()
     cond_.wait(lock, [this] { return !needWaiting_; }); // wait main loop run done
 }
 
-void GstPlayerBuild::DestroyLoop() const
+void GstPlayerBuild::DestroyLoop()
 {
+    std::unique_lock<std::mutex> lock(mutex_);
+    quit_ = true;
     if (loop_ != nullptr && g_main_loop_is_running(loop_)) {
         MEDIA_LOGI("Main loop still running, quit");
         g_main_loop_quit(loop_);
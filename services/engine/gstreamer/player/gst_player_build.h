@@ -31,8 +31,9 @@ public:
     ~GstPlayerBuild();
     DISALLOW_COPY_AND_MOVE(GstPlayerBuild);
     std::shared_ptr<GstPlayerCtrl> Build(sptr<Surface> surface = nullptr);
+    void SetSurface(const sptr<Surface> &surface);
     void CreateLoop();
-    void DestroyLoop() const;
+    void DestroyLoop();
     void WaitMainLoopStart();
     static gboolean MainLoopRunCb(GstPlayerBuild *build);
 
@@ -48,6 +49,8 @@ private:
     std::mutex mutex_;
     std::condition_variable cond_;
     bool needWaiting_ = true;
+    // the loop is destroyed before it runs, such as the build is given up for a timeout
+    bool quit_ = false;
 };
 } // Media
 } // OHOS
@@ -22,6 +22,10 @@
 namespace {
     constexpr float INVALID_VOLUME = -1.0;
     constexpr double DEFAULT_RATE = 1.0;
+    // at or above this rate, and for any backward rate, only the keyframes are played without audio
+    constexpr double TRICK_PLAY_MIN_RATE = 4.0;
+    constexpr uint32_t TRICK_PLAY_SEEK_FLAGS =
+        GST_SEEK_FLAG_TRICKMODE | GST_SEEK_FLAG_TRICKMODE_KEY_UNITS | GST_SEEK_FLAG_TRICKMODE_NO_AUDIO;
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstPlayerCtrl"};
     constexpr int MILLI = 1000;
     constexpr int MICRO = MILLI * 1000;
@@ -55,6 +59,11 @@ namespace {
         { GST_RESOURCE_ERROR_NOT_AUTHORIZED, MSERR_FILE_ACCESS_FAILED },
         { GST_RESOURCE_ERROR_TIME_OUT, MSERR_NETWORK_TIMEOUT },
     };
+
+    bool IsTrickPlayRate(double rate)
+    {
+        return rate < 0.0 || rate >= TRICK_PLAY_MIN_RATE;
+    }
 }
 
 namespace OHOS {
@@ -79,6 +88,8 @@ GstPlayerCtrl::~GstPlayerCtrl()
     for (auto &signalId : signalIds_) {
         g_signal_handler_disconnect(gstPlayer_, signalId);
     }
+    RemoveTrickPlayProbe();
+    RemoveNextSourceWatch();
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
@@ -132,6 +143,28 @@ int32_t GstPlayerCtrl::SetSource(const std::shared_ptr<GstAppsrcWarp> &appsrcWar
     return MSERR_OK;
 }
 
+int32_t GstPlayerCtrl::SetNextUrl(const std::string &url)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(gstPlayer_ != nullptr, MSERR_INVALID_OPERATION, "gstPlayer_ is nullptr");
+    {
+        std::unique_lock<std::mutex> nextLock(nextUrlMutex_);
+        nextUrl_ = url;
+    }
+    if (aboutToFinishId_ != 0) {
+        return MSERR_OK;
+    }
+
+    GstElement *playbin = gst_player_get_pipeline(gstPlayer_);
+    CHECK_AND_RETURN_RET_LOG(playbin != nullptr, MSERR_INVALID_OPERATION, "playbin is null");
+
+    // playbin asks for the next uri once the current one is fully demuxed, and switches to it without eos.
+    aboutToFinishId_ = g_signal_connect(playbin, "about-to-finish", G_CALLBACK(OnAboutToFinishCb), this);
+    AddNextSourceProbe(*playbin);
+    gst_object_unref(playbin);
+    return MSERR_OK;
+}
+
 int32_t GstPlayerCtrl::SetCallbacks(const std::weak_ptr<IPlayerEngineObs> &obs)
 {
     CHECK_AND_RETURN_RET_LOG(obs.lock() != nullptr,
@@ -271,7 +304,10 @@ int32_t GstPlayerCtrl::Seek(uint64_t position, const PlayerSeekMode mode)
     }
 
     position = (position > sourceDuration_) ? sourceDuration_ : position;
-    auto task = std::make_shared<TaskHandler<void>>([this, position, mode] { SeekSync(position, mode); });
+    // the seek runs ahead of the play or pause still queued, the seek position is what the user waits for
+    ITaskHandler::Attribute attr;
+    attr.priority_ = ITaskHandler::PRIORITY_HIGH;
+    auto task = std::make_shared<TaskHandler<void>>([this, position, mode] { SeekSync(position, mode); }, attr);
     if (taskQue_.EnqueueTask(task) != 0) {
         MEDIA_LOGE("Seek fail");
         return MSERR_INVALID_OPERATION;
@@ -354,6 +390,8 @@ void GstPlayerCtrl::Stop()
         gst_object_unref(audioSink_);
         audioSink_ = nullptr;
     }
+    RemoveTrickPlayProbe();
+    RemoveNextSourceWatch();
     if (rateTask_ != nullptr) {
         rateTask_->Cancel();
         rateTask_ = nullptr;
@@ -465,6 +503,9 @@ void GstPlayerCtrl::SetRateSync(double rate)
     CHECK_AND_RETURN_LOG(gstPlayer_ != nullptr, "gstPlayer_ is nullptr");
     MEDIA_LOGD("SetRateSync in, rate=(%{public}lf)", rate);
     (void)GetPositionInner();
+    if (IsTrickPlayRate(rate)) {
+        AddTrickPlayProbe();
+    }
     speeding_ = true;
     gst_player_set_rate(gstPlayer_, static_cast<gdouble>(rate));
 
@@ -472,6 +513,76 @@ void GstPlayerCtrl::SetRateSync(double rate)
     MEDIA_LOGD("SetRateSync out, rate=(%{public}lf)", rate);
 }
 
+void GstPlayerCtrl::AddTrickPlayProbe()
+{
+    if (trickPlayProbeId_ != 0) {
+        return;
+    }
+
+    GstElement *playbin = gst_player_get_pipeline(gstPlayer_);
+    CHECK_AND_RETURN_LOG(playbin != nullptr, "playbin is null");
+
+    GstElement *videoSink = nullptr;
+    g_object_get(playbin, "video-sink", &videoSink, nullptr);
+    gst_object_unref(playbin);
+    CHECK_AND_RETURN_LOG(videoSink != nullptr, "no video sink, the trick play falls back to the plain rate");
+
+    // the gstplayer issues the rate seek through the video sink, amend its flags on the way upstream.
+    trickPlayPad_ = gst_element_get_static_pad(videoSink, "sink");
+    gst_object_unref(videoSink);
+    CHECK_AND_RETURN_LOG(trickPlayPad_ != nullptr, "get video sink pad fail");
+
+    trickPlayProbeId_ = gst_pad_add_probe(trickPlayPad_, GST_PAD_PROBE_TYPE_EVENT_UPSTREAM,
+        TrickPlaySeekProbeCb, nullptr, nullptr);
+}
+
+void GstPlayerCtrl::RemoveTrickPlayProbe()
+{
+    if (trickPlayPad_ == nullptr) {
+        return;
+    }
+    if (trickPlayProbeId_ != 0) {
+        gst_pad_remove_probe(trickPlayPad_, trickPlayProbeId_);
+        trickPlayProbeId_ = 0;
+    }
+    gst_object_unref(trickPlayPad_);
+    trickPlayPad_ = nullptr;
+}
+
+GstPadProbeReturn GstPlayerCtrl::TrickPlaySeekProbeCb(GstPad *pad, GstPadProbeInfo *info, gpointer userData)
+{
+    (void)pad;
+    (void)userData;
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT(info);
+    if (event == nullptr || GST_EVENT_TYPE(event) != GST_EVENT_SEEK) {
+        return GST_PAD_PROBE_OK;
+    }
+
+    gdouble rate = DEFAULT_RATE;
+    GstFormat format = GST_FORMAT_UNDEFINED;
+    GstSeekFlags flags = GST_SEEK_FLAG_NONE;
+    GstSeekType startType = GST_SEEK_TYPE_NONE;
+    GstSeekType stopType = GST_SEEK_TYPE_NONE;
+    gint64 start = 0;
+    gint64 stop = 0;
+    gst_event_parse_seek(event, &rate, &format, &flags, &startType, &start, &stopType, &stop);
+    if (!IsTrickPlayRate(rate) || (flags & GST_SEEK_FLAG_TRICKMODE_KEY_UNITS) != 0) {
+        return GST_PAD_PROBE_OK;
+    }
+
+    // the demuxer then pushes the keyframes only, and the audio path only sends gaps.
+    uint32_t trickFlags = (static_cast<uint32_t>(flags) | TRICK_PLAY_SEEK_FLAGS) & ~GST_SEEK_FLAG_ACCURATE;
+    GstEvent *trickEvent = gst_event_new_seek(rate, format, static_cast<GstSeekFlags>(trickFlags),
+        startType, start, stopType, stop);
+    CHECK_AND_RETURN_RET_LOG(trickEvent != nullptr, GST_PAD_PROBE_OK, "create trick play seek fail");
+    gst_event_set_seqnum(trickEvent, gst_event_get_seqnum(event));
+
+    gst_event_unref(event);
+    GST_PAD_PROBE_INFO_DATA(info) = trickEvent;
+    MEDIA_LOGD("trick play seek, rate=(%{public}lf)", rate);
+    return GST_PAD_PROBE_OK;
+}
+
 double GstPlayerCtrl::GetRate()
 {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -590,6 +701,179 @@ void GstPlayerCtrl::ProcessEndOfStream(const GstPlayer *cbPlayer)
     }
 }
 
+void GstPlayerCtrl::OnAboutToFinishCb(GstElement *playbin, GstPlayerCtrl *playerGst)
+{
+    CHECK_AND_RETURN_LOG(playbin != nullptr, "playbin is null");
+    CHECK_AND_RETURN_LOG(playerGst != nullptr, "playerGst is null");
+    playerGst->ProcessAboutToFinish(*playbin);
+}
+
+void GstPlayerCtrl::ProcessAboutToFinish(GstElement &playbin)
+{
+    if (enableLooping_) {
+        MEDIA_LOGI("looping, keep the current source");
+        return;
+    }
+
+    std::string url;
+    {
+        std::unique_lock<std::mutex> nextLock(nextUrlMutex_);
+        std::swap(url, nextUrl_);
+    }
+    if (url.empty()) {
+        return;
+    }
+
+    MEDIA_LOGI("about to finish, preroll the next source");
+    nextSourceSwitching_ = true;
+    g_object_set(&playbin, "uri", url.c_str(), nullptr);
+}
+
+void GstPlayerCtrl::AddNextSourceProbe(GstElement &playbin)
+{
+    // the silence between the sources is measured on the audio sink, the video sink only tells the switch.
+    GstElement *sink = nullptr;
+    g_object_get(&playbin, "audio-sink", &sink, nullptr);
+    if (sink == nullptr) {
+        g_object_get(&playbin, "video-sink", &sink, nullptr);
+    }
+    CHECK_AND_RETURN_LOG(sink != nullptr, "no sink to watch the next source");
+
+    nextSourcePad_ = gst_element_get_static_pad(sink, "sink");
+    gst_object_unref(sink);
+    CHECK_AND_RETURN_LOG(nextSourcePad_ != nullptr, "get sink pad fail");
+
+    gst_segment_init(&nextSourceSegment_, GST_FORMAT_UNDEFINED);
+    lastBufferEnd_ = GST_CLOCK_TIME_NONE;
+    awaitingNextSourceBuffer_ = false;
+    nextSourceProbeId_ = gst_pad_add_probe(nextSourcePad_,
+        static_cast<GstPadProbeType>(GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM),
+        NextSourceProbeCb, this, nullptr);
+}
+
+void GstPlayerCtrl::RemoveNextSourceWatch()
+{
+    if (nextSourcePad_ != nullptr) {
+        if (nextSourceProbeId_ != 0) {
+            gst_pad_remove_probe(nextSourcePad_, nextSourceProbeId_);
+            nextSourceProbeId_ = 0;
+        }
+        gst_object_unref(nextSourcePad_);
+        nextSourcePad_ = nullptr;
+    }
+
+    if (aboutToFinishId_ != 0) {
+        GstElement *playbin = gst_player_get_pipeline(gstPlayer_);
+        if (playbin != nullptr) {
+            g_signal_handler_disconnect(playbin, aboutToFinishId_);
+            gst_object_unref(playbin);
+        }
+        aboutToFinishId_ = 0;
+    }
+
+    {
+        std::unique_lock<std::mutex> nextLock(nextUrlMutex_);
+        nextUrl_.clear();
+    }
+    nextSourceSwitching_ = false;
+}
+
+GstPadProbeReturn GstPlayerCtrl::NextSourceProbeCb(GstPad *pad, GstPadProbeInfo *info, gpointer userData)
+{
+    (void)pad;
+    CHECK_AND_RETURN_RET_LOG(info != nullptr, GST_PAD_PROBE_OK, "info is null");
+    CHECK_AND_RETURN_RET_LOG(userData != nullptr, GST_PAD_PROBE_OK, "userData is null");
+    reinterpret_cast<GstPlayerCtrl *>(userData)->ProcessNextSourceProbe(*info);
+    return GST_PAD_PROBE_OK;
+}
+
+void GstPlayerCtrl::ProcessNextSourceProbe(GstPadProbeInfo &info)
+{
+    if ((GST_PAD_PROBE_INFO_TYPE(&info) & GST_PAD_PROBE_TYPE_BUFFER) != 0) {
+        GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(&info);
+        if (buffer == nullptr || nextSourceSegment_.format != GST_FORMAT_TIME || !GST_BUFFER_PTS_IS_VALID(buffer)) {
+            return;
+        }
+        GstClockTime start = gst_segment_to_running_time(&nextSourceSegment_, GST_FORMAT_TIME, GST_BUFFER_PTS(buffer));
+        if (awaitingNextSourceBuffer_) {
+            awaitingNextSourceBuffer_ = false;
+            int64_t gapUs = 0;
+            if (GST_CLOCK_TIME_IS_VALID(start) && GST_CLOCK_TIME_IS_VALID(lastBufferEnd_) && start > lastBufferEnd_) {
+                gapUs = static_cast<int64_t>((start - lastBufferEnd_) / GST_USECOND);
+            }
+            auto task = std::make_shared<TaskHandler<void>>([this, gapUs] { OnNextSourceStart(gapUs); });
+            (void)taskQue_.EnqueueTask(task);
+        }
+        if (GST_CLOCK_TIME_IS_VALID(start) && GST_BUFFER_DURATION_IS_VALID(buffer)) {
+            lastBufferEnd_ = start + GST_BUFFER_DURATION(buffer);
+        } else {
+            lastBufferEnd_ = start;
+        }
+        return;
+    }
+
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT(&info);
+    CHECK_AND_RETURN(event != nullptr);
+    switch (GST_EVENT_TYPE(event)) {
+        case GST_EVENT_STREAM_START:
+            if (nextSourceSwitching_.exchange(false)) {
+                awaitingNextSourceBuffer_ = true;
+            }
+            break;
+        case GST_EVENT_SEGMENT:
+            gst_event_copy_segment(event, &nextSourceSegment_);
+            break;
+        case GST_EVENT_FLUSH_STOP:
+            lastBufferEnd_ = GST_CLOCK_TIME_NONE;
+            break;
+        default:
+            break;
+    }
+}
+
+void GstPlayerCtrl::OnNextSourceStart(int64_t gapUs)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (isExit_) {
+            return;
+        }
+        InitDuration();
+    }
+
+    MEDIA_LOGI("next source start, gap: %{public}" PRIi64 " us", gapUs);
+    OnMessage(PlayerMessageType::PLAYER_INFO_NEXT_SOURCE_START);
+
+    Format format;
+    (void)format.PutLongValue(PLAYER_NEXT_SOURCE_GAP, gapUs);
+    RefreshMediaInfo(format);
+    std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
+    if (tempObs != nullptr) {
+        tempObs->OnInfo(INFO_TYPE_EXTRA_FORMAT, 0, format);
+    }
+}
+
+void GstPlayerCtrl::RefreshMediaInfo(Format &format)
+{
+    // the next uri is set on playbin directly, GstPlayer only follows the streams of the new source
+    CHECK_AND_RETURN_LOG(gstPlayer_ != nullptr, "gstPlayer_ is nullptr");
+    GstPlayerMediaInfo *mediaInfo = gst_player_get_media_info(gstPlayer_);
+    CHECK_AND_RETURN_LOG(mediaInfo != nullptr, "no media info of the next source");
+
+    guint videoTracks = gst_player_media_info_get_number_of_video_streams(mediaInfo);
+    guint audioTracks = gst_player_media_info_get_number_of_audio_streams(mediaInfo);
+    (void)format.PutIntValue(PLAYER_NEXT_SOURCE_VIDEO_TRACKS, static_cast<int32_t>(videoTracks));
+    (void)format.PutIntValue(PLAYER_NEXT_SOURCE_AUDIO_TRACKS, static_cast<int32_t>(audioTracks));
+    MEDIA_LOGI("next source tracks, video: %{public}u, audio: %{public}u", videoTracks, audioTracks);
+
+    GList *videoStreams = gst_player_media_info_get_video_streams(mediaInfo);
+    if (videoStreams != nullptr && GST_IS_PLAYER_VIDEO_INFO(videoStreams->data)) {
+        GstPlayerVideoInfo *videoInfo = GST_PLAYER_VIDEO_INFO(videoStreams->data);
+        OnResolutionChange(gst_player_video_info_get_width(videoInfo), gst_player_video_info_get_height(videoInfo));
+    }
+    g_object_unref(mediaInfo);
+}
+
 void GstPlayerCtrl::StreamDecErrorParse(const gchar *name, int32_t &errorCode)
 {
     if (strstr(name, "aac") != nullptr) {
@@ -901,6 +1185,39 @@ void GstPlayerCtrl::ProcessPositionUpdated(const GstPlayer *cbPlayer, uint64_t p
             position, FAKE_POINTER(this));
         tempObs->OnInfo(INFO_TYPE_POSITION_UPDATE, static_cast<int32_t>(position), format);
     }
+    OnFrameStatistics();
+}
+
+void GstPlayerCtrl::SetVideoRendererCtrl(const std::weak_ptr<GstPlayerVideoRendererCtrl> &rendererCtrl)
+{
+    rendererCtrl_ = rendererCtrl;
+}
+
+void GstPlayerCtrl::OnFrameStatistics()
+{
+    std::shared_ptr<GstPlayerVideoRendererCtrl> rendererCtrl = rendererCtrl_.lock();
+    CHECK_AND_RETURN(rendererCtrl != nullptr);
+    uint64_t rendered = 0;
+    uint64_t dropped = 0;
+    uint64_t late = 0;
+    rendererCtrl->GetFrameStatistics(rendered, dropped, late);
+    // only report when the playback has degraded since the last report
+    if (dropped == reportedDroppedFrames_ && late == reportedLateFrames_) {
+        return;
+    }
+    reportedDroppedFrames_ = dropped;
+    reportedLateFrames_ = late;
+
+    Format format;
+    (void)format.PutLongValue(PLAYER_VIDEO_FRAMES_RENDERED, static_cast<int64_t>(rendered));
+    (void)format.PutLongValue(PLAYER_VIDEO_FRAMES_DROPPED, static_cast<int64_t>(dropped));
+    (void)format.PutLongValue(PLAYER_VIDEO_FRAMES_LATE, static_cast<int64_t>(late));
+    std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
+    if (tempObs != nullptr) {
+        MEDIA_LOGI("video frames rendered %{public}" PRIu64 ", dropped %{public}" PRIu64 ", late %{public}" PRIu64 "",
+            rendered, dropped, late);
+        tempObs->OnInfo(INFO_TYPE_EXTRA_FORMAT, 0, format);
+    }
 }
 
 void GstPlayerCtrl::OnVolumeChangeCb(const GObject *combiner, const GParamSpec *pspec, const GstPlayerCtrl *playerGst)
@@ -984,11 +1301,11 @@ void GstPlayerCtrl::OnSeekDone()
 void GstPlayerCtrl::OnEndOfStream()
 {
     if (endOfStreamCb_) {
-        MEDIA_LOGI("On EndOfStream: loop is %{public}d", enableLooping_);
+        MEDIA_LOGI("On EndOfStream: loop is %{public}d", enableLooping_.load());
         std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
         Format format;
         if (tempObs != nullptr) {
-            tempObs->OnInfo(INFO_TYPE_EOS, static_cast<int32_t>(enableLooping_), format);
+            tempObs->OnInfo(INFO_TYPE_EOS, static_cast<int32_t>(enableLooping_.load()), format);
         }
         endOfStreamCb_ = false;
     }
@@ -16,6 +16,7 @@
 #ifndef GST_PLAYER_CTRL_H
 #define GST_PLAYER_CTRL_H
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "i_player_engine.h"
 #include "task_queue.h"
 #include "gst_appsrc_warp.h"
+#include "gst_player_video_renderer_ctrl.h"
 
 namespace OHOS {
 namespace Media {
@@ -34,6 +36,7 @@ public:
     DISALLOW_COPY_AND_MOVE(GstPlayerCtrl);
     int32_t SetUrl(const std::string &url);
     int32_t SetSource(const std::shared_ptr<GstAppsrcWarp> &appsrcWarp);
+    int32_t SetNextUrl(const std::string &url);
     int32_t SetCallbacks(const std::weak_ptr<IPlayerEngineObs> &obs);
     void SetVideoTrack(bool enable);
     void Pause();
@@ -52,6 +55,7 @@ public:
     void SetRingBufferMaxSize(uint64_t size);
     void SetBufferingInfo();
     void SetHttpTimeOut();
+    void SetVideoRendererCtrl(const std::weak_ptr<GstPlayerVideoRendererCtrl> &rendererCtrl);
     static void OnStateChangedCb(const GstPlayer *player, GstPlayerState state, GstPlayerCtrl *playerGst);
     static void OnEndOfStreamCb(const GstPlayer *player, GstPlayerCtrl *playerGst);
     static void StreamDecErrorParse(const gchar *name, int32_t &errorCode);
@@ -72,6 +76,9 @@ public:
         GstPlayerCtrl *playerGst);
     static void OnMqNumUseBufferingCb(const GstPlayer *player, guint mqNumUseBuffering, GstPlayerCtrl *playerGst);
     static void OnRenderFirstVideoFrameCb(const GstPlayer *player, const GstPlayerCtrl *playerGst);
+    static GstPadProbeReturn TrickPlaySeekProbeCb(GstPad *pad, GstPadProbeInfo *info, gpointer userData);
+    static void OnAboutToFinishCb(GstElement *playbin, GstPlayerCtrl *playerGst);
+    static GstPadProbeReturn NextSourceProbeCb(GstPad *pad, GstPadProbeInfo *info, gpointer userData);
 private:
     PlayerStates ProcessStoppedState();
     PlayerStates ProcessPausedState();
@@ -90,6 +97,14 @@ private:
     void PlaySync();
     void SeekSync(uint64_t position, const PlayerSeekMode mode);
     void SetRateSync(double rate);
+    void AddTrickPlayProbe();
+    void RemoveTrickPlayProbe();
+    void AddNextSourceProbe(GstElement &playbin);
+    void RemoveNextSourceWatch();
+    void ProcessAboutToFinish(GstElement &playbin);
+    void ProcessNextSourceProbe(GstPadProbeInfo &info);
+    void OnNextSourceStart(int64_t gapUs);
+    void RefreshMediaInfo(Format &format);
     void PauseSync();
     void OnNotify(PlayerStates state);
     void GetAudioSink();
@@ -99,15 +114,18 @@ private:
     void ProcessCachedPercent(const GstPlayer *cbPlayer, int32_t percent);
     void ProcessBufferingTime(const GstPlayer *cbPlayer, guint64 bufferingTime, guint mqNumId);
     void ProcessMqNumUseBuffering(const GstPlayer *cbPlayer, uint32_t mqNumUseBuffering);
+    void OnFrameStatistics();
     std::mutex mutex_;
     std::condition_variable condVarPlaySync_;
     std::condition_variable condVarPauseSync_;
     std::condition_variable condVarStopSync_;
     std::condition_variable condVarSeekSync_;
     GstPlayer *gstPlayer_ = nullptr;
+    // the tasks wait for the state change or seek done without a timeout, so the queue owns its thread
     TaskQueue taskQue_;
     std::weak_ptr<IPlayerEngineObs> obs_;
-    bool enableLooping_ = false;
+    // read by the streaming threads at the end of a source
+    std::atomic<bool> enableLooping_ { false };
     bool bufferingStart_ = false;
     bool nextSeekFlag_ = false;
     bool userStop_ = false;
@@ -130,11 +148,26 @@ private:
     std::shared_ptr<ITaskHandler> seekTask_ = nullptr;
     std::shared_ptr<ITaskHandler> rateTask_ = nullptr;
     double rate_; // inited at the constructor
+    GstPad *trickPlayPad_ = nullptr;
+    gulong trickPlayProbeId_ = 0;
+    std::mutex nextUrlMutex_;
+    std::string nextUrl_;
+    gulong aboutToFinishId_ = 0;
+    GstPad *nextSourcePad_ = nullptr;
+    gulong nextSourceProbeId_ = 0;
+    // the following are only touched at the streaming thread of the watched sink, except the switching flag.
+    std::atomic<bool> nextSourceSwitching_ { false };
+    bool awaitingNextSourceBuffer_ = false;
+    GstSegment nextSourceSegment_;
+    GstClockTime lastBufferEnd_ = GST_CLOCK_TIME_NONE;
     uint64_t lastTime_ = 0;
     bool speeding_ = false;
     bool isExit_ = true;
     bool seeking_ = false;
     std::map<guint, guint64> mqBufferingTime_;
+    std::weak_ptr<GstPlayerVideoRendererCtrl> rendererCtrl_;
+    uint64_t reportedDroppedFrames_ = 0;
+    uint64_t reportedLateFrames_ = 0;
 };
 } // Media
 } // OHOS
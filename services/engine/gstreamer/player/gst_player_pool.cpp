@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gst_player_pool.h"
+#include "media_log.h"
+#include "media_errors.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstPlayerPool"};
+    // keep only one started player aside, every idle one holds a thread and a playbin.
+    constexpr size_t MAX_IDLE_SHELLS = 1;
+    constexpr int32_t BUILD_TIMEOUT_MS = 1000;
+    constexpr int32_t ACQUIRE_TIMEOUT_MS = 1000;
+}
+
+namespace OHOS {
+namespace Media {
+GstPlayerShell::GstPlayerShell()
+{
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
+}
+
+GstPlayerShell::~GstPlayerShell()
+{
+    if (build_ != nullptr) {
+        // after a build timeout the loop may not run yet, it is quit as soon as it starts
+        build_->DestroyLoop();
+    }
+
+    if (thread_ != nullptr && thread_->joinable()) {
+        thread_->join();
+    }
+
+    ctrl_ = nullptr;
+    build_ = nullptr;
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
+}
+
+int32_t GstPlayerShell::Start()
+{
+    build_ = std::make_unique<GstPlayerBuild>();
+    CHECK_AND_RETURN_RET_LOG(build_ != nullptr, MSERR_NO_MEMORY, "new GstPlayerBuild failed");
+
+    thread_.reset(new(std::nothrow) std::thread(&GstPlayerShell::Run, this));
+    CHECK_AND_RETURN_RET_LOG(thread_ != nullptr, MSERR_NO_MEMORY, "new std::thread failed");
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        (void)cond_.wait_for(lock, std::chrono::milliseconds(BUILD_TIMEOUT_MS), [this] { return buildDone_; });
+        CHECK_AND_RETURN_RET_LOG(ctrl_ != nullptr, MSERR_INVALID_VAL, "gstplayer initialized failed");
+    }
+
+    build_->WaitMainLoopStart();
+    return MSERR_OK;
+}
+
+void GstPlayerShell::Run()
+{
+    MEDIA_LOGD("PlayerLoop in");
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // the surface is bound later by SetSurface, the main context must be pushed at this thread.
+        ctrl_ = build_->Build(nullptr);
+        buildDone_ = true;
+        cond_.notify_all();
+        CHECK_AND_RETURN_LOG(ctrl_ != nullptr, "playerCtrl is nullptr");
+    }
+
+    MEDIA_LOGD("Start the player loop");
+    build_->CreateLoop();
+    MEDIA_LOGD("Stop the player loop");
+}
+
+void GstPlayerShell::SetSurface(const sptr<Surface> &surface)
+{
+    CHECK_AND_RETURN_LOG(build_ != nullptr, "build_ is nullptr");
+    build_->SetSurface(surface);
+}
+
+std::shared_ptr<GstPlayerCtrl> GstPlayerShell::GetCtrl() const
+{
+    return ctrl_;
+}
+
+GstPlayerPool &GstPlayerPool::Inst()
+{
+    // never destroyed, the idle player threads may be still running at the process exit.
+    static GstPlayerPool *inst = new GstPlayerPool();
+    return *inst;
+}
+
+GstPlayerPool::GstPlayerPool() : warmQue_("GstPlayerWarm")
+{
+    (void)warmQue_.Start();
+}
+
+GstPlayerPool::~GstPlayerPool()
+{
+    (void)warmQue_.Stop();
+}
+
+void GstPlayerPool::Warm()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (warming_ || idleShells_.size() >= MAX_IDLE_SHELLS) {
+        return;
+    }
+
+    auto task = std::make_shared<TaskHandler<void>>([this] { WarmOne(); });
+    CHECK_AND_RETURN_LOG(warmQue_.EnqueueTask(task) == MSERR_OK, "enqueue warm task failed");
+    warming_ = true;
+}
+
+void GstPlayerPool::WarmOne()
+{
+    auto shell = std::make_unique<GstPlayerShell>();
+    if (shell != nullptr && shell->Start() != MSERR_OK) {
+        MEDIA_LOGW("warm gstplayer failed");
+        shell = nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (shell != nullptr) {
+        idleShells_.push_back(std::move(shell));
+    }
+    warming_ = false;
+    cond_.notify_all();
+}
+
+std::unique_ptr<GstPlayerShell> GstPlayerPool::Acquire()
+{
+    std::unique_ptr<GstPlayerShell> shell = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // a warming one is about to be ready, waiting for it is never slower than starting another.
+        (void)cond_.wait_for(lock, std::chrono::milliseconds(ACQUIRE_TIMEOUT_MS),
+            [this] { return !warming_ || !idleShells_.empty(); });
+        if (!idleShells_.empty()) {
+            shell = std::move(idleShells_.front());
+            idleShells_.pop_front();
+            hitCount_++;
+        } else {
+            missCount_++;
+        }
+        MEDIA_LOGI("acquire gstplayer %{public}s, hit: %{public}" PRIu64 ", miss: %{public}" PRIu64 "",
+            shell != nullptr ? "warmed" : "cold", hitCount_, missCount_);
+    }
+
+    if (shell == nullptr) {
+        shell = std::make_unique<GstPlayerShell>();
+        if (shell != nullptr && shell->Start() != MSERR_OK) {
+            shell = nullptr;
+        }
+    }
+    return shell;
+}
+
+void GstPlayerPool::Recycle(std::unique_ptr<GstPlayerShell> shell)
+{
+    // a used gstplayer keeps the uri, callbacks and sinks of its session, so it is torn down
+    // instead of being put back. The next source set warms a fresh one.
+    shell = nullptr;
+}
+} // Media
+} // OHOS
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GST_PLAYER_POOL_H
+#define GST_PLAYER_POOL_H
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "gst_player_build.h"
+#include "task_queue.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * A gstplayer whose main loop is already running at its own thread, but not bound to any source yet.
+ */
+class GstPlayerShell {
+public:
+    GstPlayerShell();
+    ~GstPlayerShell();
+    DISALLOW_COPY_AND_MOVE(GstPlayerShell);
+
+    int32_t Start();
+    void SetSurface(const sptr<Surface> &surface);
+    std::shared_ptr<GstPlayerCtrl> GetCtrl() const;
+
+private:
+    void Run();
+
+    std::unique_ptr<GstPlayerBuild> build_ = nullptr;
+    std::shared_ptr<GstPlayerCtrl> ctrl_ = nullptr;
+    std::unique_ptr<std::thread> thread_ = nullptr;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool buildDone_ = false;
+};
+
+/**
+ * Keeps a bounded number of started shells, so that preparing a player does not wait for the
+ * gstplayer to be created and its main loop to start.
+ */
+class GstPlayerPool {
+public:
+    static GstPlayerPool &Inst();
+
+    void Warm();
+    std::unique_ptr<GstPlayerShell> Acquire();
+    void Recycle(std::unique_ptr<GstPlayerShell> shell);
+
+private:
+    GstPlayerPool();
+    ~GstPlayerPool();
+    void WarmOne();
+
+    TaskQueue warmQue_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::list<std::unique_ptr<GstPlayerShell>> idleShells_;
+    bool warming_ = false;
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+};
+} // Media
+} // OHOS
+#endif // GST_PLAYER_POOL_H
@@ -14,6 +14,10 @@
  */
 
 #include "gst_player_video_renderer_ctrl.h"
+#include <algorithm>
+#include "gst_surface_allocator.h"
+#include "gst_surface_pool.h"
+#include "gst/base/gstbasesink.h"
 #include "display_type.h"
 #include "media_log.h"
 #include "param_wrapper.h"
@@ -24,8 +28,27 @@ namespace {
     constexpr uint32_t MAX_DEFAULT_WIDTH = 10000;
     constexpr uint32_t MAX_DEFAULT_HEIGHT = 10000;
     constexpr uint32_t DEFAULT_BUFFER_NUM = 8;
-    constexpr uint32_t MAX_DEFAULT_TRY_TIMES = 100;
-    constexpr uint32_t DEFAULT_WAIT_TIME = 5000;
+    // without a release notification the surface is polled at this interval
+    constexpr int64_t DEFAULT_WAIT_TIME = 5000;
+    // the wait for a free surface buffer is bounded by the frame interval, clamped to this range
+    constexpr int64_t MIN_REQUEST_WAIT_TIME = 10000;
+    constexpr int64_t MAX_REQUEST_WAIT_TIME = 500000;
+    constexpr int64_t REQUEST_WAIT_FRAMES = 2;
+    constexpr int64_t NS_PER_US = 1000;
+    // a frame later than this against the pipeline clock is dropped instead of flushed
+    constexpr GstClockTimeDiff MAX_LATENESS = 20 * GST_MSECOND;
+    // a flushed frame later than this counts as a late frame
+    constexpr GstClockTimeDiff LATE_FRAME_THRESHOLD = 5 * GST_MSECOND;
+    // the surface buffers proposed to the decoder leave this many in the queue for the copy path
+    constexpr uint32_t COPY_PATH_BUFFER_NUM = 1;
+
+    // the decoder still holds a frame it uses as a reference, such a surface buffer can not be handed to the
+    // consumer, the surface would give it back to the decoder for the next frame while it is still referenced.
+    // The decoder keeps its reference frames mapped, the render path itself never maps the surface memory.
+    bool IsReferencedByDecoder(GstMemory &memory)
+    {
+        return gst_surface_memory_is_mapped(&memory) || !gst_memory_is_exclusive(&memory);
+    }
 }
 
 namespace OHOS {
@@ -42,6 +65,7 @@ public:
         gulong &signalId);
     static GstFlowReturn VideoDataAvailableCb(const GstElement *appsink, const gpointer userData);
     static GstPadProbeReturn SinkPadProbeCb(GstPad *pad, GstPadProbeInfo *info, gpointer userData);
+    static sptr<SurfaceBuffer> RequestSurfaceBufferCb(guint width, guint height, gpointer userData);
 };
 
 struct _PlayerVideoRenderer {
@@ -137,6 +161,11 @@ GstElement *GstPlayerVideoRendererCap::CreateVideoSink(const GstCaps *caps,
     signalId = g_signal_connect(G_OBJECT(sink), "new_sample", G_CALLBACK(callback), userData);
     g_object_set(G_OBJECT(sink), "caps", caps, nullptr);
     g_object_set(G_OBJECT(sink), "emit-signals", TRUE, nullptr);
+    // the rendered surface buffer is given to the consumer, do not keep it as the last sample
+    g_object_set(G_OBJECT(sink), "enable-last-sample", FALSE, nullptr);
+    // let the sink drop the samples arriving too late and send qos upstream, so the decoder can skip frames
+    g_object_set(G_OBJECT(sink), "qos", TRUE, nullptr);
+    g_object_set(G_OBJECT(sink), "max-lateness", static_cast<gint64>(MAX_LATENESS), nullptr);
 
     GstPad *pad = gst_element_get_static_pad(sink, "sink");
     if (pad == nullptr) {
@@ -166,26 +195,58 @@ GstFlowReturn GstPlayerVideoRendererCap::VideoDataAvailableCb(const GstElement *
 GstPadProbeReturn GstPlayerVideoRendererCap::SinkPadProbeCb(GstPad *pad, GstPadProbeInfo *info, gpointer userData)
 {
     (void)pad;
-    (void)userData;
     GstQuery *query = GST_PAD_PROBE_INFO_QUERY(info);
     if (GST_QUERY_TYPE(query) == GST_QUERY_ALLOCATION) {
         GstCaps *caps = nullptr;
         gboolean needPool;
         gst_query_parse_allocation(query, &caps, &needPool);
+        CHECK_AND_RETURN_RET_LOG(caps != nullptr, GST_PAD_PROBE_OK, "allocation query without caps");
 
         auto s = gst_caps_get_structure(caps, 0);
         auto mediaType = gst_structure_get_name(s);
         gboolean isVideo = g_str_has_prefix(mediaType, "video/");
         if (isVideo) {
             gst_query_add_allocation_meta(query, GST_VIDEO_META_API_TYPE, nullptr);
+            if (needPool && userData != nullptr) {
+                auto ctrl = reinterpret_cast<GstPlayerVideoRendererCtrl *>(userData);
+                ctrl->ProposeSurfacePool(query, caps);
+            }
         }
     }
     return GST_PAD_PROBE_OK;
 }
 
+sptr<SurfaceBuffer> GstPlayerVideoRendererCap::RequestSurfaceBufferCb(guint width, guint height, gpointer userData)
+{
+    CHECK_AND_RETURN_RET_LOG(userData != nullptr, nullptr, "userData is nullptr..");
+    auto ctrl = reinterpret_cast<GstPlayerVideoRendererCtrl *>(userData);
+    return ctrl->RequestBuffer(width, height, -1);
+}
+
+uint64_t SurfaceReleaseNotifier::GetSequence()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return sequence_;
+}
+
+void SurfaceReleaseNotifier::Notify()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    sequence_++;
+    cond_.notify_all();
+}
+
+bool SurfaceReleaseNotifier::WaitUntil(uint64_t sequence, std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cond_.wait_until(lock, deadline, [this, sequence] { return sequence_ != sequence; });
+}
+
 GstPlayerVideoRendererCtrl::GstPlayerVideoRendererCtrl(const sptr<Surface> &surface)
     : producerSurface_(surface),
-      surfaceTimeMonitor_(SURFACE_TIME_TAG)
+      surfaceTimeMonitor_(SURFACE_TIME_TAG),
+      releaseNotifier_(std::make_shared<SurfaceReleaseNotifier>()),
+      lastRequestWaitUs_(MAX_REQUEST_WAIT_TIME)
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
     SetSurfaceTimeFromSysPara();
@@ -193,6 +254,7 @@ GstPlayerVideoRendererCtrl::GstPlayerVideoRendererCtrl(const sptr<Surface> &surf
 
 GstPlayerVideoRendererCtrl::~GstPlayerVideoRendererCtrl()
 {
+    ResetSurfacePool();
     g_signal_handler_disconnect(G_OBJECT(videoSink_), signalId_);
     producerSurface_ = nullptr;
     if (videoSink_ != nullptr) {
@@ -211,6 +273,11 @@ GstPlayerVideoRendererCtrl::~GstPlayerVideoRendererCtrl()
         gst_caps_unref(videoCaps_);
         videoCaps_ = nullptr;
     }
+    MEDIA_LOGI("video frames rendered %{public}" PRIu64 ", dropped %{public}" PRIu64 ", late %{public}" PRIu64 "",
+        renderedFrames_.load(), droppedFrames_.load(), lateFrames_.load());
+    MEDIA_LOGI("surface buffer waited %{public}" PRIu64 " times, %{public}" PRId64 " us in total, "
+        "%{public}" PRIu64 " timeouts", requestWaitCount_.load(), requestWaitTimeUs_.load(),
+        requestTimeoutCount_.load());
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
@@ -234,10 +301,115 @@ int32_t GstPlayerVideoRendererCtrl::InitVideoSink(const GstElement *playbin)
     }
     if (producerSurface_ != nullptr) {
         producerSurface_->SetQueueSize(DEFAULT_BUFFER_NUM);
+        RegisterReleaseListener();
+    }
+    return MSERR_OK;
+}
+
+int32_t GstPlayerVideoRendererCtrl::SetSurface(const sptr<Surface> &surface)
+{
+    // only before the pipeline starts, the streaming threads read the surface without lock.
+    if (producerSurface_ != surface) {
+        UnregisterReleaseListener();
+    }
+    producerSurface_ = surface;
+    if (videoSink_ == nullptr) {
+        return MSERR_OK; // InitVideoSink creates the caps from the surface later
+    }
+
+    std::string formatName = GetVideoSinkFormat();
+    GstCaps *caps = gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING, formatName.c_str(), nullptr);
+    CHECK_AND_RETURN_RET_LOG(caps != nullptr, MSERR_INVALID_OPERATION, "gst_caps_new_simple failed..");
+    g_object_set(G_OBJECT(videoSink_), "caps", caps, nullptr);
+    if (videoCaps_ != nullptr) {
+        gst_caps_unref(videoCaps_);
+    }
+    videoCaps_ = caps;
+
+    if (producerSurface_ != nullptr) {
+        producerSurface_->SetQueueSize(DEFAULT_BUFFER_NUM);
+        RegisterReleaseListener();
     }
     return MSERR_OK;
 }
 
+void GstPlayerVideoRendererCtrl::ProposeSurfacePool(GstQuery *query, GstCaps *caps)
+{
+    CHECK_AND_RETURN(producerSurface_ != nullptr);
+    GstVideoInfo info;
+    CHECK_AND_RETURN_LOG(gst_video_info_from_caps(&info, caps), "parse video caps failed");
+
+    // a new allocation query means new caps, the previous pool is left to its outstanding buffers
+    ResetSurfacePool();
+    surfacePool_ = gst_surface_pool_new(producerSurface_);
+    CHECK_AND_RETURN_LOG(surfacePool_ != nullptr, "create surface pool failed");
+    gst_surface_pool_set_request_func(surfacePool_, GstPlayerVideoRendererCap::RequestSurfaceBufferCb, this);
+
+    // bound the surface buffers held by the decoder by the surface queue, the pool uses system memory above it
+    uint32_t queueSize = producerSurface_->GetQueueSize();
+    guint maxBuffers = queueSize > COPY_PATH_BUFFER_NUM ? queueSize - COPY_PATH_BUFFER_NUM : 1;
+    GstStructure *config = gst_buffer_pool_get_config(surfacePool_);
+    gst_buffer_pool_config_set_params(config, caps, static_cast<guint>(GST_VIDEO_INFO_SIZE(&info)), 0, maxBuffers);
+    gst_buffer_pool_config_add_option(config, GST_BUFFER_POOL_OPTION_VIDEO_META);
+    if (!gst_buffer_pool_set_config(surfacePool_, config)) {
+        MEDIA_LOGW("set surface pool config failed, copy the frames instead");
+        ResetSurfacePool();
+        return;
+    }
+    gst_query_add_allocation_pool(query, surfacePool_, static_cast<guint>(GST_VIDEO_INFO_SIZE(&info)), 0,
+        maxBuffers);
+    MEDIA_LOGI("propose surface pool for %{public}dx%{public}d, max %{public}u buffers", GST_VIDEO_INFO_WIDTH(&info),
+        GST_VIDEO_INFO_HEIGHT(&info), maxBuffers);
+}
+
+void GstPlayerVideoRendererCtrl::ResetSurfacePool()
+{
+    if (surfacePool_ != nullptr) {
+        gst_surface_pool_set_request_func(surfacePool_, nullptr, nullptr);
+        gst_object_unref(surfacePool_);
+        surfacePool_ = nullptr;
+    }
+}
+
+void GstPlayerVideoRendererCtrl::RegisterReleaseListener()
+{
+    if (releaseListenerRegistered_) {
+        return;
+    }
+    // the surface may outlive this ctrl, so the listener only holds the notifier weakly
+    std::weak_ptr<SurfaceReleaseNotifier> notifier = releaseNotifier_;
+    SurfaceError ret = producerSurface_->RegisterReleaseListener([notifier](sptr<SurfaceBuffer> &buffer) {
+        (void)buffer;
+        std::shared_ptr<SurfaceReleaseNotifier> releaseNotifier = notifier.lock();
+        if (releaseNotifier != nullptr) {
+            releaseNotifier->Notify();
+        }
+        return SURFACE_ERROR_OK;
+    });
+    if (ret != SURFACE_ERROR_OK) {
+        MEDIA_LOGW("register release listener failed(ret = %{public}d), poll the surface instead", ret);
+        return;
+    }
+    releaseListenerRegistered_ = true;
+}
+
+void GstPlayerVideoRendererCtrl::UnregisterReleaseListener()
+{
+    if (!releaseListenerRegistered_) {
+        return;
+    }
+    releaseListenerRegistered_ = false;
+    CHECK_AND_RETURN(producerSurface_ != nullptr);
+    // the surface keeps a single release listener, replacing it drops the notifier of this ctrl
+    SurfaceError ret = producerSurface_->RegisterReleaseListener([](sptr<SurfaceBuffer> &buffer) {
+        (void)buffer;
+        return SURFACE_ERROR_OK;
+    });
+    if (ret != SURFACE_ERROR_OK) {
+        MEDIA_LOGW("unregister release listener failed(ret = %{public}d)", ret);
+    }
+}
+
 std::string GstPlayerVideoRendererCtrl::GetVideoSinkFormat() const
 {
     std::string formatName = "NV21";
@@ -289,7 +461,7 @@ int32_t GstPlayerVideoRendererCtrl::PullVideoBuffer()
         return MSERR_INVALID_OPERATION;
     }
 
-    int32_t ret = UpdateSurfaceBuffer(*buf);
+    int32_t ret = UpdateSurfaceBuffer(*buf, gst_sample_get_segment(sample));
     if (ret != MSERR_OK) {
         MEDIA_LOGE("Failed to update surface buffer and please provide the sptr<Surface>!");
     }
@@ -314,11 +486,11 @@ void GstPlayerVideoRendererCtrl::SetSurfaceTimeFromSysPara()
     }
 }
 
-BufferRequestConfig GstPlayerVideoRendererCtrl::UpdateRequestConfig(const GstVideoMeta *videoMeta) const
+BufferRequestConfig GstPlayerVideoRendererCtrl::UpdateRequestConfig(uint32_t width, uint32_t height) const
 {
     BufferRequestConfig config;
-    config.width = static_cast<int32_t>(videoMeta->width);
-    config.height = static_cast<int32_t>(videoMeta->height);
+    config.width = static_cast<int32_t>(width);
+    config.height = static_cast<int32_t>(height);
     constexpr int32_t strideAlignment = 8;
     const std::string surfaceFormat = "SURFACE_FORMAT";
     config.strideAlignment = strideAlignment;
@@ -333,28 +505,120 @@ BufferRequestConfig GstPlayerVideoRendererCtrl::UpdateRequestConfig(const GstVid
     return config;
 }
 
-sptr<SurfaceBuffer> GstPlayerVideoRendererCtrl::RequestBuffer(const GstVideoMeta *videoMeta) const
+int64_t GstPlayerVideoRendererCtrl::GetRequestWaitTime(const GstBuffer &buffer)
+{
+    GstClockTime interval = GST_BUFFER_DURATION(&buffer);
+    GstClockTime pts = GST_BUFFER_PTS(&buffer);
+    if (!GST_CLOCK_TIME_IS_VALID(interval) && GST_CLOCK_TIME_IS_VALID(pts) &&
+        GST_CLOCK_TIME_IS_VALID(lastPts_) && pts > lastPts_) {
+        interval = pts - lastPts_;
+    }
+    lastPts_ = pts;
+    if (!GST_CLOCK_TIME_IS_VALID(interval)) {
+        return MAX_REQUEST_WAIT_TIME;
+    }
+    // a frame still waiting for a buffer after this long would be shown late anyway
+    int64_t waitUs = static_cast<int64_t>(interval / NS_PER_US) * REQUEST_WAIT_FRAMES;
+    waitUs = std::min(std::max(waitUs, MIN_REQUEST_WAIT_TIME), MAX_REQUEST_WAIT_TIME);
+    lastRequestWaitUs_ = waitUs;
+    return waitUs;
+}
+
+sptr<SurfaceBuffer> GstPlayerVideoRendererCtrl::RequestBuffer(uint32_t width, uint32_t height, int64_t waitUs)
 {
-    CHECK_AND_RETURN_RET_LOG(videoMeta != nullptr, nullptr, "gst_buffer_get_video_meta failed..");
-    CHECK_AND_RETURN_RET_LOG(videoMeta->width < MAX_DEFAULT_WIDTH && videoMeta->height < MAX_DEFAULT_HEIGHT,
+    CHECK_AND_RETURN_RET_LOG(producerSurface_ != nullptr, nullptr, "Surface is nullptr..");
+    CHECK_AND_RETURN_RET_LOG(width < MAX_DEFAULT_WIDTH && height < MAX_DEFAULT_HEIGHT,
         nullptr, "video size too large. Video cannot be played.");
-    BufferRequestConfig requestConfig = UpdateRequestConfig(videoMeta);
+    if (waitUs < 0) {
+        // the frame is not decoded yet, bound the wait by the latest frame interval
+        waitUs = lastRequestWaitUs_;
+    }
+    BufferRequestConfig requestConfig = UpdateRequestConfig(width, height);
     sptr<SurfaceBuffer> surfaceBuffer = nullptr;
     int32_t releaseFence = -1;
     SurfaceError ret = SURFACE_ERROR_OK;
-    uint32_t count = 0;
-    do {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::microseconds(waitUs);
+    bool waited = false;
+    while (true) {
+        // take the sequence before requesting, so a release in between is not missed
+        uint64_t sequence = releaseNotifier_->GetSequence();
         ret = producerSurface_->RequestBuffer(surfaceBuffer, releaseFence, requestConfig);
-        if (ret == SURFACE_ERROR_NO_BUFFER) {
-            usleep(DEFAULT_WAIT_TIME);
-            ++count;
+        if (ret != SURFACE_ERROR_NO_BUFFER) {
+            break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            requestTimeoutCount_++;
+            break;
+        }
+        waited = true;
+        auto waitDeadline = deadline;
+        if (!releaseListenerRegistered_) {
+            waitDeadline = std::min(deadline, now + std::chrono::microseconds(DEFAULT_WAIT_TIME));
         }
-    } while (ret == SURFACE_ERROR_NO_BUFFER && count < MAX_DEFAULT_TRY_TIMES);
+        (void)releaseNotifier_->WaitUntil(sequence, waitDeadline);
+    }
+    if (waited) {
+        requestWaitCount_++;
+        requestWaitTimeUs_ += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
     CHECK_AND_RETURN_RET_LOG(ret == SURFACE_ERROR_OK, nullptr, "RequestBuffer is not ok..");
     return surfaceBuffer;
 }
 
-int32_t GstPlayerVideoRendererCtrl::UpdateSurfaceBuffer(const GstBuffer &buffer)
+void GstPlayerVideoRendererCtrl::GetFrameStatistics(uint64_t &rendered, uint64_t &dropped, uint64_t &late)
+{
+    rendered = renderedFrames_;
+    dropped = droppedFrames_;
+    late = lateFrames_;
+    CHECK_AND_RETURN(videoSink_ != nullptr);
+    // the samples dropped by the sink itself never reach the renderer
+    GstStructure *stats = nullptr;
+    g_object_get(G_OBJECT(videoSink_), "stats", &stats, nullptr);
+    CHECK_AND_RETURN(stats != nullptr);
+    guint64 sinkDropped = 0;
+    if (gst_structure_get_uint64(stats, "dropped", &sinkDropped)) {
+        dropped += sinkDropped;
+    }
+    gst_structure_free(stats);
+}
+
+GstClockTimeDiff GstPlayerVideoRendererCtrl::GetLateness(const GstBuffer &buffer, const GstSegment *segment)
+{
+    GstClockTime pts = GST_BUFFER_PTS(&buffer);
+    if (segment == nullptr || segment->format != GST_FORMAT_TIME || !GST_CLOCK_TIME_IS_VALID(pts)) {
+        return 0;
+    }
+    GstClockTime runningTime = gst_segment_to_running_time(segment, GST_FORMAT_TIME, pts);
+    CHECK_AND_RETURN_RET(GST_CLOCK_TIME_IS_VALID(runningTime), 0);
+
+    GstClock *clock = gst_element_get_clock(videoSink_);
+    CHECK_AND_RETURN_RET(clock != nullptr, 0);
+    GstClockTime now = gst_clock_get_time(clock);
+    gst_object_unref(clock);
+    GstClockTime renderTime = runningTime + gst_element_get_base_time(videoSink_) +
+        gst_base_sink_get_latency(GST_BASE_SINK(videoSink_));
+    return GST_CLOCK_DIFF(renderTime, now);
+}
+
+bool GstPlayerVideoRendererCtrl::DropLateFrame(const GstBuffer &buffer, const GstSegment *segment)
+{
+    // the sink itself reports the lateness upstream through its qos events
+    GstClockTimeDiff lateness = GetLateness(buffer, segment);
+    if (lateness > MAX_LATENESS) {
+        droppedFrames_++;
+        MEDIA_LOGD("drop frame late %{public}" PRId64 " ns", lateness);
+        return true;
+    }
+    if (lateness > LATE_FRAME_THRESHOLD) {
+        lateFrames_++;
+    }
+    return false;
+}
+
+int32_t GstPlayerVideoRendererCtrl::UpdateSurfaceBuffer(const GstBuffer &buffer, const GstSegment *segment)
 {
     CHECK_AND_RETURN_RET_LOG(producerSurface_ != nullptr, MSERR_INVALID_OPERATION,
         "Surface is nullptr.Video cannot be played.");
@@ -364,8 +628,30 @@ int32_t GstPlayerVideoRendererCtrl::UpdateSurfaceBuffer(const GstBuffer &buffer)
     auto buf = const_cast<GstBuffer *>(&buffer);
     GstVideoMeta *videoMeta = gst_buffer_get_video_meta(buf);
     CHECK_AND_RETURN_RET_LOG(videoMeta != nullptr, MSERR_INVALID_VAL, "gst_buffer_get_video_meta failed..");
-    sptr<SurfaceBuffer> surfaceBuffer = RequestBuffer(videoMeta);
+    int64_t waitUs = GetRequestWaitTime(buffer);
+    GstMemory *memory = gst_buffer_n_memory(buf) == 1 ? gst_buffer_peek_memory(buf, 0) : nullptr;
+    if (memory != nullptr && gst_is_surface_memory(memory)) {
+        // an unflushed surface memory is cancelled back to the surface when the sample is released
+        if (DropLateFrame(buffer, segment)) {
+            return MSERR_OK;
+        }
+        if (!IsReferencedByDecoder(*memory)) {
+            // decoded straight into the surface buffer, only the flush is left
+            int32_t ret = FlushSurfaceMemory(*memory, *videoMeta);
+            if (surfaceTimeEnable_) {
+                surfaceTimeMonitor_.FinishTime();
+            }
+            return ret;
+        }
+        // a reference frame is copied out, its own surface buffer is cancelled once the decoder drops it
+    }
+    sptr<SurfaceBuffer> surfaceBuffer = RequestBuffer(videoMeta->width, videoMeta->height, waitUs);
     CHECK_AND_RETURN_RET_LOG(surfaceBuffer != nullptr, MSERR_INVALID_OPERATION, "surfaceBuffer is nullptr..");
+    // waiting for the surface may have pushed the frame past its deadline
+    if (DropLateFrame(buffer, segment)) {
+        (void)producerSurface_->CancelBuffer(surfaceBuffer);
+        return MSERR_OK;
+    }
     SurfaceError ret = SURFACE_ERROR_OK;
     bool needFlush = false;
     do {
@@ -389,6 +675,7 @@ int32_t GstPlayerVideoRendererCtrl::UpdateSurfaceBuffer(const GstBuffer &buffer)
         ret = producerSurface_->FlushBuffer(surfaceBuffer, -1, flushConfig);
         CHECK_AND_RETURN_RET_LOG(ret == SURFACE_ERROR_OK, MSERR_INVALID_OPERATION,
             "FlushBuffer failed(ret = %{public}d)..", ret);
+        renderedFrames_++;
     } else {
         (void)producerSurface_->CancelBuffer(surfaceBuffer);
         return MSERR_INVALID_OPERATION;
@@ -399,6 +686,31 @@ int32_t GstPlayerVideoRendererCtrl::UpdateSurfaceBuffer(const GstBuffer &buffer)
     return MSERR_OK;
 }
 
+int32_t GstPlayerVideoRendererCtrl::FlushSurfaceMemory(GstMemory &memory, const GstVideoMeta &videoMeta)
+{
+    GstSurfaceMemory *surfaceMem = reinterpret_cast<GstSurfaceMemory *>(&memory);
+    CHECK_AND_RETURN_RET_LOG(surfaceMem->buf != nullptr, MSERR_INVALID_VAL, "surface buffer is nullptr..");
+    CHECK_AND_RETURN_RET_LOG(surfaceMem->surface.GetRefPtr() == producerSurface_.GetRefPtr(),
+        MSERR_INVALID_OPERATION, "surface buffer does not belong to the current surface");
+    if (!surfaceMem->needCancel) {
+        MEDIA_LOGW("surface buffer has already been flushed");
+        return MSERR_OK;
+    }
+
+    BufferFlushConfig flushConfig = {};
+    flushConfig.damage.x = 0;
+    flushConfig.damage.y = 0;
+    flushConfig.damage.w = videoMeta.width;
+    flushConfig.damage.h = videoMeta.height;
+    SurfaceError ret = producerSurface_->FlushBuffer(surfaceMem->buf, -1, flushConfig);
+    CHECK_AND_RETURN_RET_LOG(ret == SURFACE_ERROR_OK, MSERR_INVALID_OPERATION,
+        "FlushBuffer failed(ret = %{public}d)..", ret);
+    // the consumer owns the buffer now, it must not be cancelled when the GstMemory is freed
+    surfaceMem->needCancel = FALSE;
+    renderedFrames_++;
+    return MSERR_OK;
+}
+
 GstPlayerVideoRenderer *GstPlayerVideoRendererFactory::Create(
     const std::shared_ptr<GstPlayerVideoRendererCtrl> &rendererCtrl)
 {
@@ -16,7 +16,11 @@
 #ifndef GST_PLAYER_VIDEO_RENDERER_CTRL_H
 #define GST_PLAYER_VIDEO_RENDERER_CTRL_H
 
+#include <chrono>
+#include <condition_variable>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <gst/gst.h>
 #include <gst/player/player.h>
@@ -25,6 +29,21 @@
 
 namespace OHOS {
 namespace Media {
+class SurfaceReleaseNotifier {
+public:
+    SurfaceReleaseNotifier() = default;
+    ~SurfaceReleaseNotifier() = default;
+    DISALLOW_COPY_AND_MOVE(SurfaceReleaseNotifier);
+    uint64_t GetSequence();
+    void Notify();
+    bool WaitUntil(uint64_t sequence, std::chrono::steady_clock::time_point deadline);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    uint64_t sequence_ = 0;
+};
+
 class GstPlayerVideoRendererCtrl {
 public:
     explicit GstPlayerVideoRendererCtrl(const sptr<Surface> &surface);
@@ -32,15 +51,25 @@ public:
     DISALLOW_COPY_AND_MOVE(GstPlayerVideoRendererCtrl);
     int32_t InitVideoSink(const GstElement *playbin);
     int32_t InitAudioSink(const GstElement *playbin);
+    int32_t SetSurface(const sptr<Surface> &surface);
     const GstElement *GetVideoSink() const;
     int32_t PullVideoBuffer();
-    sptr<SurfaceBuffer> RequestBuffer(const GstVideoMeta *videoMeta) const;
-    int32_t UpdateSurfaceBuffer(const GstBuffer &buffer);
+    sptr<SurfaceBuffer> RequestBuffer(uint32_t width, uint32_t height, int64_t waitUs);
+    int32_t UpdateSurfaceBuffer(const GstBuffer &buffer, const GstSegment *segment = nullptr);
+    void ProposeSurfacePool(GstQuery *query, GstCaps *caps);
+    void GetFrameStatistics(uint64_t &rendered, uint64_t &dropped, uint64_t &late);
 
 private:
-    BufferRequestConfig UpdateRequestConfig(const GstVideoMeta *videoMeta) const;
+    BufferRequestConfig UpdateRequestConfig(uint32_t width, uint32_t height) const;
+    int32_t FlushSurfaceMemory(GstMemory &memory, const GstVideoMeta &videoMeta);
+    void ResetSurfacePool();
+    GstClockTimeDiff GetLateness(const GstBuffer &buffer, const GstSegment *segment);
+    bool DropLateFrame(const GstBuffer &buffer, const GstSegment *segment);
     std::string GetVideoSinkFormat() const;
     void SetSurfaceTimeFromSysPara();
+    void RegisterReleaseListener();
+    void UnregisterReleaseListener();
+    int64_t GetRequestWaitTime(const GstBuffer &buffer);
 
     sptr<Surface> producerSurface_ = nullptr;
     GstElement *videoSink_ = nullptr;
@@ -50,6 +79,18 @@ private:
     bool surfaceTimeEnable_ = false;
     TimeMonitor surfaceTimeMonitor_;
     gulong signalId_ = 0;
+    std::shared_ptr<SurfaceReleaseNotifier> releaseNotifier_ = nullptr;
+    bool releaseListenerRegistered_ = false;
+    GstClockTime lastPts_ = GST_CLOCK_TIME_NONE;
+    // the surface pool requests buffers from the upstream streaming thread
+    std::atomic<int64_t> lastRequestWaitUs_;
+    std::atomic<int64_t> requestWaitTimeUs_ { 0 };
+    std::atomic<uint64_t> requestWaitCount_ { 0 };
+    std::atomic<uint64_t> requestTimeoutCount_ { 0 };
+    GstBufferPool *surfacePool_ = nullptr;
+    std::atomic<uint64_t> renderedFrames_ { 0 };
+    std::atomic<uint64_t> droppedFrames_ { 0 };
+    std::atomic<uint64_t> lateFrames_ { 0 };
 };
 
 class GstPlayerVideoRendererFactory {
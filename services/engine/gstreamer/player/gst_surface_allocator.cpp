@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gst_surface_allocator.h"
+#include "media_log.h"
+
+constexpr char GST_SURFACE_MEMORY_TYPE[] = "SurfaceMemory";
+
+#define gst_surface_allocator_parent_class parent_class
+G_DEFINE_TYPE(GstSurfaceAllocator, gst_surface_allocator, GST_TYPE_ALLOCATOR);
+
+gboolean gst_is_surface_memory(GstMemory *mem)
+{
+    return gst_memory_is_type(mem, GST_SURFACE_MEMORY_TYPE);
+}
+
+gboolean gst_surface_memory_is_mapped(GstMemory *mem)
+{
+    g_return_val_if_fail(mem != nullptr && gst_is_surface_memory(mem), FALSE);
+    GstSurfaceMemory *surfaceMem = reinterpret_cast<GstSurfaceMemory *>(mem);
+    return g_atomic_int_get(&surfaceMem->mapCount) > 0;
+}
+
+GstMemory *gst_surface_allocator_wrap(GstAllocator *allocator, const OHOS::sptr<OHOS::Surface> &surface,
+    const OHOS::sptr<OHOS::SurfaceBuffer> &buf, gsize size)
+{
+    g_return_val_if_fail(allocator != nullptr && GST_IS_SURFACE_ALLOCATOR(allocator), nullptr);
+    g_return_val_if_fail(surface != nullptr && buf != nullptr, nullptr);
+    g_return_val_if_fail(buf->GetVirAddr() != nullptr, nullptr);
+    g_return_val_if_fail(buf->GetSize() >= 0 && static_cast<gsize>(buf->GetSize()) >= size, nullptr);
+
+    GstSurfaceMemory *mem = reinterpret_cast<GstSurfaceMemory *>(g_slice_alloc0(sizeof(GstSurfaceMemory)));
+    g_return_val_if_fail(mem != nullptr, nullptr);
+    gst_memory_init(GST_MEMORY_CAST(mem), GST_MEMORY_FLAG_NO_SHARE,
+        allocator, nullptr, static_cast<gsize>(buf->GetSize()), 0, 0, size);
+
+    mem->surface = surface;
+    mem->buf = buf;
+    mem->needCancel = TRUE;
+    mem->mapCount = 0;
+    GST_DEBUG_OBJECT(allocator, "wrap surface buffer for size: %" G_GSIZE_FORMAT ", addr: 0x%06" PRIXPTR "",
+        size, FAKE_POINTER(buf->GetVirAddr()));
+
+    return GST_MEMORY_CAST(mem);
+}
+
+static GstMemory *gst_surface_allocator_alloc(GstAllocator *allocator, gsize size, GstAllocationParams *params)
+{
+    (void)size;
+    (void)params;
+    GST_ERROR_OBJECT(allocator, "surface memory can only be wrapped from a requested surface buffer");
+    return nullptr;
+}
+
+static void gst_surface_allocator_free(GstAllocator *allocator, GstMemory *mem)
+{
+    g_return_if_fail(mem != nullptr && allocator != nullptr);
+    g_return_if_fail(gst_is_surface_memory(mem));
+
+    GstSurfaceMemory *surfaceMem = reinterpret_cast<GstSurfaceMemory *>(mem);
+    if (surfaceMem->needCancel && surfaceMem->surface != nullptr && surfaceMem->buf != nullptr) {
+        (void)surfaceMem->surface->CancelBuffer(surfaceMem->buf);
+    }
+    GST_DEBUG_OBJECT(allocator, "free surface memory, cancel: %d", surfaceMem->needCancel);
+    surfaceMem->buf = nullptr;
+    surfaceMem->surface = nullptr;
+    g_slice_free(GstSurfaceMemory, surfaceMem);
+}
+
+static gpointer gst_surface_allocator_mem_map(GstMemory *mem, gsize maxsize, GstMapFlags flags)
+{
+    (void)maxsize;
+    (void)flags;
+    g_return_val_if_fail(mem != nullptr, nullptr);
+    g_return_val_if_fail(gst_is_surface_memory(mem), nullptr);
+
+    GstSurfaceMemory *surfaceMem = reinterpret_cast<GstSurfaceMemory *>(mem);
+    g_return_val_if_fail(surfaceMem->buf != nullptr, nullptr);
+
+    gpointer addr = surfaceMem->buf->GetVirAddr();
+    if (addr != nullptr) {
+        g_atomic_int_inc(&surfaceMem->mapCount);
+    }
+    return addr;
+}
+
+static void gst_surface_allocator_mem_unmap(GstMemory *mem)
+{
+    g_return_if_fail(mem != nullptr);
+    g_return_if_fail(gst_is_surface_memory(mem));
+
+    GstSurfaceMemory *surfaceMem = reinterpret_cast<GstSurfaceMemory *>(mem);
+    (void)g_atomic_int_dec_and_test(&surfaceMem->mapCount);
+}
+
+static void gst_surface_allocator_init(GstSurfaceAllocator *allocator)
+{
+    GstAllocator *bAllocator = GST_ALLOCATOR_CAST(allocator);
+    g_return_if_fail(bAllocator != nullptr);
+
+    GST_DEBUG_OBJECT(allocator, "init allocator 0x%06" PRIXPTR "", FAKE_POINTER(allocator));
+
+    bAllocator->mem_type = GST_SURFACE_MEMORY_TYPE;
+    bAllocator->mem_map = (GstMemoryMapFunction)gst_surface_allocator_mem_map;
+    bAllocator->mem_unmap = (GstMemoryUnmapFunction)gst_surface_allocator_mem_unmap;
+    GST_OBJECT_FLAG_SET(allocator, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
+}
+
+static void gst_surface_allocator_finalize(GObject *obj)
+{
+    GstSurfaceAllocator *allocator = GST_SURFACE_ALLOCATOR_CAST(obj);
+    g_return_if_fail(allocator != nullptr);
+
+    GST_DEBUG_OBJECT(allocator, "finalize allocator 0x%06" PRIXPTR "", FAKE_POINTER(allocator));
+    G_OBJECT_CLASS(parent_class)->finalize(obj);
+}
+
+static void gst_surface_allocator_class_init(GstSurfaceAllocatorClass *klass)
+{
+    GObjectClass *gobjectClass = G_OBJECT_CLASS(klass);
+    g_return_if_fail(gobjectClass != nullptr);
+
+    gobjectClass->finalize = gst_surface_allocator_finalize;
+
+    GstAllocatorClass *allocatorClass = GST_ALLOCATOR_CLASS(klass);
+    g_return_if_fail(allocatorClass != nullptr);
+
+    allocatorClass->alloc = gst_surface_allocator_alloc;
+    allocatorClass->free = gst_surface_allocator_free;
+}
+
+GstAllocator *gst_surface_allocator_new()
+{
+    GstAllocator *alloc = GST_ALLOCATOR_CAST(g_object_new(
+        GST_TYPE_SURFACE_ALLOCATOR, "name", "Surface::Allocator", nullptr));
+    (void)gst_object_ref_sink(alloc);
+
+    return alloc;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GST_SURFACE_ALLOCATOR_H
+#define GST_SURFACE_ALLOCATOR_H
+
+#include <gst/gst.h>
+#include "surface.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_SURFACE_ALLOCATOR (gst_surface_allocator_get_type())
+#define GST_SURFACE_ALLOCATOR(obj) \
+    (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_SURFACE_ALLOCATOR, GstSurfaceAllocator))
+#define GST_SURFACE_ALLOCATOR_CLASS(klass) \
+    (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_SURFACE_ALLOCATOR, GstSurfaceAllocatorClass))
+#define GST_IS_SURFACE_ALLOCATOR(obj) \
+    (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_SURFACE_ALLOCATOR))
+#define GST_IS_SURFACE_ALLOCATOR_CLASS(klass) \
+    (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_SURFACE_ALLOCATOR))
+#define GST_SURFACE_ALLOCATOR_CAST(obj) ((GstSurfaceAllocator*)(obj))
+
+typedef struct _GstSurfaceAllocator GstSurfaceAllocator;
+typedef struct _GstSurfaceAllocatorClass GstSurfaceAllocatorClass;
+typedef struct _GstSurfaceMemory GstSurfaceMemory;
+
+struct _GstSurfaceAllocator {
+    GstAllocator parent;
+};
+
+struct _GstSurfaceAllocatorClass {
+    GstAllocatorClass parent;
+};
+
+struct _GstSurfaceMemory {
+    GstMemory parent;
+    OHOS::sptr<OHOS::Surface> surface;
+    OHOS::sptr<OHOS::SurfaceBuffer> buf;
+    /* the buffer goes back to the surface by cancel unless it has been flushed */
+    gboolean needCancel;
+    /* number of active mappings, a decoder keeps the frames it still references mapped */
+    gint mapCount;
+};
+
+GType gst_surface_allocator_get_type(void);
+
+GstAllocator *gst_surface_allocator_new();
+
+/* wrap one surface buffer requested from the producer surface as GstMemory of the given size */
+GstMemory *gst_surface_allocator_wrap(GstAllocator *allocator, const OHOS::sptr<OHOS::Surface> &surface,
+    const OHOS::sptr<OHOS::SurfaceBuffer> &buf, gsize size);
+
+gboolean gst_is_surface_memory(GstMemory *mem);
+
+/* whether the surface memory is mapped by anyone, e.g. a decoder still using it as a reference frame */
+gboolean gst_surface_memory_is_mapped(GstMemory *mem);
+
+G_END_DECLS
+
+#endif
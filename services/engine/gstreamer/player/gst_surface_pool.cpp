@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gst_surface_pool.h"
+#include "gst_surface_allocator.h"
+#include "surface_buffer_impl.h"
+#include "media_log.h"
+
+// while the surface buffers handed out reach the max, wait this long for one to be freed before using system memory
+constexpr gint64 SURFACE_BUFFER_WAIT_US = 50000;
+
+#define gst_surface_pool_parent_class parent_class
+G_DEFINE_TYPE(GstSurfacePool, gst_surface_pool, GST_TYPE_BUFFER_POOL);
+
+// marks the buffers holding a surface buffer, so that freeing them gives the slot back
+static GQuark gst_surface_pool_surface_buffer_quark()
+{
+    static GQuark quark = g_quark_from_static_string("GstSurfacePoolSurfaceBuffer");
+    return quark;
+}
+
+static const gchar **gst_surface_pool_get_options(GstBufferPool *pool)
+{
+    (void)pool;
+    static const gchar *options[] = { GST_BUFFER_POOL_OPTION_VIDEO_META, nullptr };
+    return options;
+}
+
+static gboolean gst_surface_pool_set_config(GstBufferPool *pool, GstStructure *config)
+{
+    GstSurfacePool *spool = GST_SURFACE_POOL_CAST(pool);
+    g_return_val_if_fail(spool != nullptr, FALSE);
+
+    GstCaps *caps = nullptr;
+    guint size = 0;
+    guint minBuffers = 0;
+    guint maxBuffers = 0;
+    if (!gst_buffer_pool_config_get_params(config, &caps, &size, &minBuffers, &maxBuffers) || caps == nullptr) {
+        GST_WARNING_OBJECT(pool, "no caps in config");
+        return FALSE;
+    }
+
+    GstVideoInfo info;
+    if (!gst_video_info_from_caps(&info, caps)) {
+        GST_WARNING_OBJECT(pool, "failed getting geometry from caps %" GST_PTR_FORMAT, caps);
+        return FALSE;
+    }
+
+    GST_OBJECT_LOCK(pool);
+    spool->info = info;
+    spool->maxBuffers = maxBuffers;
+    spool->systemMemory = FALSE;
+    GST_OBJECT_UNLOCK(pool);
+
+    // the max only bounds the surface buffers, the pool falls back to system memory above it instead of blocking
+    caps = gst_caps_ref(caps);
+    gst_buffer_pool_config_set_params(config, caps, size, minBuffers, 0);
+    gst_caps_unref(caps);
+    return GST_BUFFER_POOL_CLASS(parent_class)->set_config(pool, config);
+}
+
+// the surface lays the planes out one after another with its own luma stride, the stride and the height of each
+// plane follow the subsampling of its components. Returns the total size of the planes.
+static gsize gst_surface_pool_layout_planes(const GstVideoInfo *info, gint stride,
+    gsize offset[GST_VIDEO_MAX_PLANES], gint planeStride[GST_VIDEO_MAX_PLANES])
+{
+    const GstVideoFormatInfo *finfo = info->finfo;
+    gint pixelStride = GST_VIDEO_FORMAT_INFO_PSTRIDE(finfo, 0) > 0 ? GST_VIDEO_FORMAT_INFO_PSTRIDE(finfo, 0) : 1;
+    gsize planeOffset = 0;
+    for (guint plane = 0; plane < GST_VIDEO_INFO_N_PLANES(info); ++plane) {
+        guint comp = 0;
+        while (comp < GST_VIDEO_FORMAT_INFO_N_COMPONENTS(finfo) - 1 &&
+            GST_VIDEO_FORMAT_INFO_PLANE(finfo, comp) != plane) {
+            comp++;
+        }
+        planeStride[plane] = GST_VIDEO_FORMAT_INFO_SCALE_WIDTH(finfo, comp, stride / pixelStride) *
+            GST_VIDEO_FORMAT_INFO_PSTRIDE(finfo, comp);
+        offset[plane] = planeOffset;
+        gint planeHeight = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT(finfo, comp, GST_VIDEO_INFO_HEIGHT(info));
+        planeOffset += static_cast<gsize>(planeStride[plane]) * static_cast<gsize>(planeHeight);
+    }
+    return planeOffset;
+}
+
+static GstFlowReturn gst_surface_pool_alloc_system_buffer(GstVideoInfo &info, GstBuffer **buffer)
+{
+    *buffer = gst_buffer_new_allocate(nullptr, GST_VIDEO_INFO_SIZE(&info), nullptr);
+    g_return_val_if_fail(*buffer != nullptr, GST_FLOW_ERROR);
+    (void)gst_buffer_add_video_meta_full(*buffer, GST_VIDEO_FRAME_FLAG_NONE, GST_VIDEO_INFO_FORMAT(&info),
+        GST_VIDEO_INFO_WIDTH(&info), GST_VIDEO_INFO_HEIGHT(&info), GST_VIDEO_INFO_N_PLANES(&info),
+        info.offset, info.stride);
+    return GST_FLOW_OK;
+}
+
+// called with the object lock held, waits a while for a slot if max surface buffers are out.
+// Returns whether a slot is taken for a new surface buffer.
+static gboolean gst_surface_pool_reserve_surface_buffer(GstSurfacePool *spool)
+{
+    gint64 deadline = g_get_monotonic_time() + SURFACE_BUFFER_WAIT_US;
+    while (!spool->flushing && !spool->systemMemory && spool->maxBuffers > 0 &&
+        spool->surfaceBuffers >= spool->maxBuffers) {
+        if (!g_cond_wait_until(&spool->cond, GST_OBJECT_GET_LOCK(spool), deadline)) {
+            break;
+        }
+    }
+    if (spool->flushing || spool->systemMemory ||
+        (spool->maxBuffers > 0 && spool->surfaceBuffers >= spool->maxBuffers)) {
+        return FALSE;
+    }
+    spool->surfaceBuffers++;
+    return TRUE;
+}
+
+static void gst_surface_pool_unreserve_surface_buffer(GstSurfacePool *spool)
+{
+    GST_OBJECT_LOCK(spool);
+    if (spool->surfaceBuffers > 0) {
+        spool->surfaceBuffers--;
+    }
+    g_cond_signal(&spool->cond);
+    GST_OBJECT_UNLOCK(spool);
+}
+
+static void gst_surface_pool_use_system_memory(GstSurfacePool *spool)
+{
+    GST_OBJECT_LOCK(spool);
+    spool->systemMemory = TRUE;
+    GST_OBJECT_UNLOCK(spool);
+}
+
+static GstFlowReturn gst_surface_pool_alloc_buffer(GstBufferPool *pool, GstBuffer **buffer,
+    GstBufferPoolAcquireParams *params)
+{
+    (void)params;
+    GstSurfacePool *spool = GST_SURFACE_POOL_CAST(pool);
+    g_return_val_if_fail(spool != nullptr && buffer != nullptr, GST_FLOW_ERROR);
+
+    GST_OBJECT_LOCK(pool);
+    GstSurfacePoolRequestFunc requestFunc = spool->requestFunc;
+    gpointer userData = spool->userData;
+    GstVideoInfo info = spool->info;
+    gboolean reserved = requestFunc != nullptr && gst_surface_pool_reserve_surface_buffer(spool);
+    gboolean flushing = spool->flushing;
+    GST_OBJECT_UNLOCK(pool);
+    g_return_val_if_fail(requestFunc != nullptr, GST_FLOW_FLUSHING);
+    if (flushing) {
+        return GST_FLOW_FLUSHING;
+    }
+    if (!reserved) {
+        return gst_surface_pool_alloc_system_buffer(info, buffer);
+    }
+
+    OHOS::sptr<OHOS::SurfaceBuffer> surfaceBuffer = requestFunc(GST_VIDEO_INFO_WIDTH(&info),
+        GST_VIDEO_INFO_HEIGHT(&info), userData);
+    if (surfaceBuffer == nullptr) {
+        GST_INFO_OBJECT(pool, "no surface buffer released in time, use system memory");
+        gst_surface_pool_unreserve_surface_buffer(spool);
+        return gst_surface_pool_alloc_system_buffer(info, buffer);
+    }
+
+    OHOS::sptr<OHOS::SurfaceBufferImpl> bufferImpl = OHOS::SurfaceBufferImpl::FromBase(surfaceBuffer);
+    BufferHandle *handle = bufferImpl != nullptr ? bufferImpl->GetBufferHandle() : nullptr;
+    gint stride = handle != nullptr ? handle->stride : 0;
+    gint infoStride = GST_VIDEO_INFO_PLANE_STRIDE(&info, 0);
+    if (stride < infoStride || infoStride <= 0) {
+        GST_WARNING_OBJECT(pool, "surface stride %d can not hold video stride %d, use system memory",
+            stride, infoStride);
+        (void)spool->surface->CancelBuffer(surfaceBuffer);
+        gst_surface_pool_use_system_memory(spool);
+        gst_surface_pool_unreserve_surface_buffer(spool);
+        return gst_surface_pool_alloc_system_buffer(info, buffer);
+    }
+
+    gsize offset[GST_VIDEO_MAX_PLANES] = { 0 };
+    gint planeStride[GST_VIDEO_MAX_PLANES] = { 0 };
+    gsize size = gst_surface_pool_layout_planes(&info, stride, offset, planeStride);
+
+    GstMemory *memory = gst_surface_allocator_wrap(spool->allocator, spool->surface, surfaceBuffer, size);
+    if (memory == nullptr) {
+        GST_WARNING_OBJECT(pool, "wrap surface buffer failed, need size %" G_GSIZE_FORMAT ", use system memory",
+            size);
+        (void)spool->surface->CancelBuffer(surfaceBuffer);
+        gst_surface_pool_use_system_memory(spool);
+        gst_surface_pool_unreserve_surface_buffer(spool);
+        return gst_surface_pool_alloc_system_buffer(info, buffer);
+    }
+
+    *buffer = gst_buffer_new();
+    gst_buffer_append_memory(*buffer, memory);
+    (void)gst_buffer_add_video_meta_full(*buffer, GST_VIDEO_FRAME_FLAG_NONE, GST_VIDEO_INFO_FORMAT(&info),
+        GST_VIDEO_INFO_WIDTH(&info), GST_VIDEO_INFO_HEIGHT(&info), GST_VIDEO_INFO_N_PLANES(&info),
+        offset, planeStride);
+    gst_mini_object_set_qdata(GST_MINI_OBJECT_CAST(*buffer), gst_surface_pool_surface_buffer_quark(),
+        GINT_TO_POINTER(TRUE), nullptr);
+    return GST_FLOW_OK;
+}
+
+static void gst_surface_pool_release_buffer(GstBufferPool *pool, GstBuffer *buffer)
+{
+    GstSurfacePool *spool = GST_SURFACE_POOL_CAST(pool);
+    gboolean isSurfaceBuffer =
+        gst_mini_object_get_qdata(GST_MINI_OBJECT_CAST(buffer), gst_surface_pool_surface_buffer_quark()) != nullptr;
+    GST_OBJECT_LOCK(pool);
+    gboolean recycle = !isSurfaceBuffer && spool->systemMemory;
+    GST_OBJECT_UNLOCK(pool);
+    // a surface buffer is flushed or cancelled once used, it never goes back to the pool queue. Neither does a
+    // system memory buffer handed out while the surface was short of buffers, the next alloc tries the surface.
+    if (!recycle) {
+        GST_BUFFER_FLAG_SET(buffer, GST_BUFFER_FLAG_TAG_MEMORY);
+    }
+    GST_BUFFER_POOL_CLASS(parent_class)->release_buffer(pool, buffer);
+}
+
+static void gst_surface_pool_free_buffer(GstBufferPool *pool, GstBuffer *buffer)
+{
+    gboolean isSurfaceBuffer =
+        gst_mini_object_get_qdata(GST_MINI_OBJECT_CAST(buffer), gst_surface_pool_surface_buffer_quark()) != nullptr;
+    // the surface buffer goes back to the surface here, only then the slot is free
+    GST_BUFFER_POOL_CLASS(parent_class)->free_buffer(pool, buffer);
+    if (isSurfaceBuffer) {
+        gst_surface_pool_unreserve_surface_buffer(GST_SURFACE_POOL_CAST(pool));
+    }
+}
+
+static void gst_surface_pool_flush_start(GstBufferPool *pool)
+{
+    GstSurfacePool *spool = GST_SURFACE_POOL_CAST(pool);
+    GST_OBJECT_LOCK(pool);
+    spool->flushing = TRUE;
+    g_cond_broadcast(&spool->cond);
+    GST_OBJECT_UNLOCK(pool);
+}
+
+static void gst_surface_pool_flush_stop(GstBufferPool *pool)
+{
+    GstSurfacePool *spool = GST_SURFACE_POOL_CAST(pool);
+    GST_OBJECT_LOCK(pool);
+    spool->flushing = FALSE;
+    GST_OBJECT_UNLOCK(pool);
+}
+
+static void gst_surface_pool_finalize(GObject *obj)
+{
+    g_return_if_fail(obj != nullptr);
+    GstSurfacePool *spool = GST_SURFACE_POOL_CAST(obj);
+
+    spool->surface = nullptr;
+    if (spool->allocator != nullptr) {
+        gst_object_unref(spool->allocator);
+        spool->allocator = nullptr;
+    }
+    g_cond_clear(&spool->cond);
+
+    G_OBJECT_CLASS(parent_class)->finalize(obj);
+}
+
+static void gst_surface_pool_class_init(GstSurfacePoolClass *klass)
+{
+    g_return_if_fail(klass != nullptr);
+    GstBufferPoolClass *poolClass = GST_BUFFER_POOL_CLASS(klass);
+    g_return_if_fail(poolClass != nullptr);
+    GObjectClass *gobjectClass = G_OBJECT_CLASS(klass);
+    g_return_if_fail(gobjectClass != nullptr);
+
+    gobjectClass->finalize = gst_surface_pool_finalize;
+    poolClass->get_options = gst_surface_pool_get_options;
+    poolClass->set_config = gst_surface_pool_set_config;
+    poolClass->alloc_buffer = gst_surface_pool_alloc_buffer;
+    poolClass->release_buffer = gst_surface_pool_release_buffer;
+    poolClass->free_buffer = gst_surface_pool_free_buffer;
+    poolClass->flush_start = gst_surface_pool_flush_start;
+    poolClass->flush_stop = gst_surface_pool_flush_stop;
+}
+
+static void gst_surface_pool_init(GstSurfacePool *pool)
+{
+    g_return_if_fail(pool != nullptr);
+    pool->allocator = gst_surface_allocator_new();
+    gst_video_info_init(&pool->info);
+    pool->requestFunc = nullptr;
+    pool->userData = nullptr;
+    pool->maxBuffers = 0;
+    pool->surfaceBuffers = 0;
+    g_cond_init(&pool->cond);
+    pool->flushing = FALSE;
+    pool->systemMemory = FALSE;
+}
+
+GstBufferPool *gst_surface_pool_new(const OHOS::sptr<OHOS::Surface> &surface)
+{
+    g_return_val_if_fail(surface != nullptr, nullptr);
+    GstBufferPool *pool = GST_BUFFER_POOL_CAST(g_object_new(
+        GST_TYPE_SURFACE_POOL, "name", "SurfacePool", nullptr));
+    (void)gst_object_ref_sink(pool);
+    GST_SURFACE_POOL_CAST(pool)->surface = surface;
+
+    return pool;
+}
+
+void gst_surface_pool_set_request_func(GstBufferPool *pool, GstSurfacePoolRequestFunc func, gpointer userData)
+{
+    g_return_if_fail(pool != nullptr && GST_IS_SURFACE_POOL(pool));
+    GstSurfacePool *spool = GST_SURFACE_POOL_CAST(pool);
+
+    GST_OBJECT_LOCK(pool);
+    spool->requestFunc = func;
+    spool->userData = userData;
+    g_cond_broadcast(&spool->cond);
+    GST_OBJECT_UNLOCK(pool);
+}
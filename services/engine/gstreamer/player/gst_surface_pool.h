@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GST_SURFACE_POOL_H
+#define GST_SURFACE_POOL_H
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include "surface.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_SURFACE_POOL (gst_surface_pool_get_type())
+#define GST_SURFACE_POOL(obj) \
+    (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_SURFACE_POOL, GstSurfacePool))
+#define GST_SURFACE_POOL_CLASS(klass) \
+    (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_SURFACE_POOL, GstSurfacePoolClass))
+#define GST_IS_SURFACE_POOL(obj) \
+    (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_SURFACE_POOL))
+#define GST_IS_SURFACE_POOL_CLASS(klass) \
+    (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_SURFACE_POOL))
+#define GST_SURFACE_POOL_CAST(obj) ((GstSurfacePool*)(obj))
+
+typedef struct _GstSurfacePool GstSurfacePool;
+typedef struct _GstSurfacePoolClass GstSurfacePoolClass;
+
+/* request one free buffer of the producer surface, return nullptr if none is released in time.
+ * The pool then hands out a system memory buffer instead, which the renderer copies to the surface. */
+typedef OHOS::sptr<OHOS::SurfaceBuffer> (*GstSurfacePoolRequestFunc)(guint width, guint height, gpointer userData);
+
+struct _GstSurfacePool {
+    GstBufferPool basepool;
+    GstAllocator *allocator;
+    GstVideoInfo info;
+    OHOS::sptr<OHOS::Surface> surface;
+    GstSurfacePoolRequestFunc requestFunc;
+    gpointer userData;
+    /* max surface buffers handed out at once, taken from the config, 0 for no limit */
+    guint maxBuffers;
+    /* surface buffers handed out and not freed yet, protected by the object lock */
+    guint surfaceBuffers;
+    GCond cond;
+    gboolean flushing;
+    /* the surface buffers can not hold the video layout, only system memory is handed out */
+    gboolean systemMemory;
+};
+
+struct _GstSurfacePoolClass {
+    GstBufferPoolClass basepool_class;
+};
+
+GType gst_surface_pool_get_type(void);
+
+GstBufferPool *gst_surface_pool_new(const OHOS::sptr<OHOS::Surface> &surface);
+
+/* the pool fails to alloc once the request func is reset to nullptr */
+void gst_surface_pool_set_request_func(GstBufferPool *pool, GstSurfacePoolRequestFunc func, gpointer userData);
+
+G_END_DECLS
+
+#endif
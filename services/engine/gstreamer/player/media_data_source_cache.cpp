@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "media_data_source_cache.h"
+#include <algorithm>
+#include "media_log.h"
+#include "media_errors.h"
+#include "securec.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaDataSourceCache"};
+    constexpr int64_t CACHE_PAGE_SIZE = 32768;
+    constexpr int64_t DEFAULT_CACHE_CAPACITY = 4194304; // 4 * 1024 * 1024
+}
+
+namespace OHOS {
+namespace Media {
+MediaDataSourceCache::MediaDataSourceCache(const std::shared_ptr<IMediaDataSource> &dataSrc, int64_t size)
+    : dataSrc_(dataSrc),
+      size_(size),
+      capacity_(DEFAULT_CACHE_CAPACITY)
+{
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
+}
+
+MediaDataSourceCache::~MediaDataSourceCache()
+{
+    DumpStatistics();
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
+}
+
+int32_t MediaDataSourceCache::ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem)
+{
+    // no order is known for the reads coming through the plain interface
+    return ReadAt(pos, length, mem, false);
+}
+
+int32_t MediaDataSourceCache::ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem,
+    bool sequential)
+{
+    CHECK_AND_RETURN_RET_LOG(dataSrc_ != nullptr, SOURCE_ERROR_IO, "dataSrc_ is nullptr");
+    CHECK_AND_RETURN_RET_LOG(mem != nullptr && mem->GetBase() != nullptr, SOURCE_ERROR_IO, "mem is nullptr");
+    uint32_t readLen = std::min(length, static_cast<uint32_t>(mem->GetSize()));
+    std::vector<PageData> hit;
+    bool found = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        found = capacity_ > 0 && FindInCacheLocked(pos, readLen, hit);
+    }
+    // the pages are copied without the lock, so that the concurrent reads do not wait for each other
+    if (found) {
+        int32_t hitLen = CopyFromPages(pos, readLen, hit, mem->GetBase());
+        if (hitLen > 0) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            hitCount_++;
+            hitBytes_ += static_cast<uint64_t>(hitLen);
+            return hitLen;
+        }
+    }
+
+    int32_t ret = dataSrc_->ReadAt(pos, length, mem);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    missCount_++;
+    if (ret > 0) {
+        missBytes_ += static_cast<uint64_t>(ret);
+        if (capacity_ > 0) {
+            SaveToCacheLocked(pos, std::min(ret, mem->GetSize()), mem->GetBase(), sequential);
+        }
+    }
+    return ret;
+}
+
+int32_t MediaDataSourceCache::ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem)
+{
+    CHECK_AND_RETURN_RET_LOG(dataSrc_ != nullptr, SOURCE_ERROR_IO, "dataSrc_ is nullptr");
+    return dataSrc_->ReadAt(length, mem);
+}
+
+int32_t MediaDataSourceCache::GetSize(int64_t &size)
+{
+    size = size_;
+    return MSERR_OK;
+}
+
+void MediaDataSourceCache::SetCapacity(int64_t capacity)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    capacity_ = capacity > 0 ? capacity : 0;
+    EvictLocked();
+    while (static_cast<int64_t>(ghostPages_.size()) * CACHE_PAGE_SIZE > capacity_) {
+        (void)ghostMap_.erase(ghostPages_.back());
+        ghostPages_.pop_back();
+    }
+    MEDIA_LOGI("cache capacity %{public}" PRId64 "", capacity_);
+}
+
+void MediaDataSourceCache::Clear()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    pageMap_.clear();
+    pages_.clear();
+    ghostMap_.clear();
+    ghostPages_.clear();
+    usedBytes_ = 0;
+}
+
+MediaDataSourceCache::Statistics MediaDataSourceCache::GetStatistics()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return Statistics { hitCount_, missCount_, hitBytes_, missBytes_ };
+}
+
+void MediaDataSourceCache::DumpStatistics()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    MEDIA_LOGI("cache hit %{public}" PRIu64 " (%{public}" PRIu64 " bytes), miss %{public}" PRIu64
+        " (%{public}" PRIu64 " bytes), used %{public}" PRId64 " of %{public}" PRId64 " bytes",
+        hitCount_, hitBytes_, missCount_, missBytes_, usedBytes_, capacity_);
+}
+
+int32_t MediaDataSourceCache::GetPageValidSize(uint64_t index) const
+{
+    int64_t pageStart = static_cast<int64_t>(index) * CACHE_PAGE_SIZE;
+    return static_cast<int32_t>(std::min(CACHE_PAGE_SIZE, size_ - pageStart));
+}
+
+bool MediaDataSourceCache::FindInCacheLocked(int64_t pos, uint32_t length, std::vector<PageData> &hit)
+{
+    if (pos < 0 || pos >= size_ || length == 0) {
+        return false;
+    }
+    int64_t end = std::min(pos + static_cast<int64_t>(length), size_);
+    uint64_t first = static_cast<uint64_t>(pos / CACHE_PAGE_SIZE);
+    uint64_t last = static_cast<uint64_t>((end - 1) / CACHE_PAGE_SIZE);
+    for (uint64_t index = first; index <= last; ++index) {
+        if (pageMap_.find(index) == pageMap_.end()) {
+            return false;
+        }
+    }
+
+    for (uint64_t index = first; index <= last; ++index) {
+        PageIter iter = pageMap_[index];
+        hit.push_back(iter->data);
+        // most recently used page stays at the front
+        pages_.splice(pages_.begin(), pages_, iter);
+    }
+    return true;
+}
+
+int32_t MediaDataSourceCache::CopyFromPages(int64_t pos, uint32_t length, const std::vector<PageData> &hit,
+    uint8_t *dst) const
+{
+    int64_t end = std::min(pos + static_cast<int64_t>(length), size_);
+    int64_t pageStart = (pos / CACHE_PAGE_SIZE) * CACHE_PAGE_SIZE;
+    uint8_t *out = dst;
+    for (const PageData &data : hit) {
+        int64_t copyStart = std::max(pos, pageStart) - pageStart;
+        int64_t copyEnd = std::min(end, pageStart + static_cast<int64_t>(data->size())) - pageStart;
+        size_t copyLen = static_cast<size_t>(copyEnd - copyStart);
+        CHECK_AND_RETURN_RET_LOG(memcpy_s(out, copyLen, data->data() + copyStart, copyLen) == EOK,
+            0, "copy from cache failed");
+        out += copyLen;
+        pageStart += CACHE_PAGE_SIZE;
+    }
+    return static_cast<int32_t>(end - pos);
+}
+
+void MediaDataSourceCache::SaveToCacheLocked(int64_t pos, int32_t length, const uint8_t *src, bool sequential)
+{
+    int64_t end = pos + length;
+    // only the pages completely covered by this read are cached
+    uint64_t index = static_cast<uint64_t>((pos + CACHE_PAGE_SIZE - 1) / CACHE_PAGE_SIZE);
+    while (true) {
+        int64_t pageStart = static_cast<int64_t>(index) * CACHE_PAGE_SIZE;
+        if (pageStart >= size_) {
+            break;
+        }
+        int32_t validSize = GetPageValidSize(index);
+        if (pageStart + validSize > end || validSize > capacity_) {
+            break;
+        }
+        auto found = pageMap_.find(index);
+        if (found != pageMap_.end()) {
+            pages_.splice(pages_.begin(), pages_, found->second);
+        } else if (sequential && !TakeGhostLocked(index)) {
+            // first sequential pass over the page, remember it and leave the data uncached
+            AddGhostLocked(index);
+        } else {
+            const uint8_t *pageSrc = src + (pageStart - pos);
+            CachePage page { index, std::make_shared<const std::vector<uint8_t>>(pageSrc, pageSrc + validSize) };
+            pages_.push_front(std::move(page));
+            pageMap_[index] = pages_.begin();
+            usedBytes_ += validSize;
+        }
+        index++;
+    }
+    EvictLocked();
+}
+
+bool MediaDataSourceCache::TakeGhostLocked(uint64_t index)
+{
+    auto found = ghostMap_.find(index);
+    if (found == ghostMap_.end()) {
+        return false;
+    }
+    ghostPages_.erase(found->second);
+    (void)ghostMap_.erase(found);
+    return true;
+}
+
+void MediaDataSourceCache::AddGhostLocked(uint64_t index)
+{
+    if (ghostMap_.find(index) != ghostMap_.end()) {
+        return;
+    }
+    // remember as many pages as the cache can hold, only the indexes are kept
+    while (!ghostPages_.empty() && static_cast<int64_t>(ghostPages_.size() + 1) * CACHE_PAGE_SIZE > capacity_) {
+        (void)ghostMap_.erase(ghostPages_.back());
+        ghostPages_.pop_back();
+    }
+    ghostPages_.push_front(index);
+    ghostMap_[index] = ghostPages_.begin();
+}
+
+void MediaDataSourceCache::EvictLocked()
+{
+    while (usedBytes_ > capacity_ && !pages_.empty()) {
+        CachePage &page = pages_.back();
+        usedBytes_ -= static_cast<int64_t>(page.data->size());
+        (void)pageMap_.erase(page.index);
+        pages_.pop_back();
+    }
+}
+} // namespace Media
+} // namespace OHOS
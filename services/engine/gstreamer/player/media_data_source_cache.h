@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEDIA_DATA_SOURCE_CACHE_H
+#define MEDIA_DATA_SOURCE_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "media_data_source.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * LRU byte-range cache in front of a random access IMediaDataSource. The file is split into
+ * fixed-size pages keyed by file offset, so the demuxer back-seeks and repeated header reads
+ * are served locally instead of going through the data source again. The plain sequential reads,
+ * as told by the caller which knows the order of its reads, are not cached on the first pass, only
+ * their page indexes are remembered, so the linear playback neither copies each read nor pushes the
+ * re-read pages out of the cache.
+ */
+class MediaDataSourceCache : public IMediaDataSource {
+public:
+    MediaDataSourceCache(const std::shared_ptr<IMediaDataSource> &dataSrc, int64_t size);
+    ~MediaDataSourceCache();
+    DISALLOW_COPY_AND_MOVE(MediaDataSourceCache);
+
+    int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
+    int32_t ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
+    int32_t GetSize(int64_t &size) override;
+    int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem, bool sequential);
+
+    struct Statistics {
+        uint64_t hitCount;
+        uint64_t missCount;
+        uint64_t hitBytes;
+        uint64_t missBytes;
+    };
+    void SetCapacity(int64_t capacity);
+    void Clear();
+    Statistics GetStatistics();
+    void DumpStatistics();
+
+private:
+    // shared with the readers copying out of it, so an evicted page stays valid until they are done
+    using PageData = std::shared_ptr<const std::vector<uint8_t>>;
+    struct CachePage {
+        uint64_t index;
+        PageData data;
+    };
+    using PageIter = std::list<CachePage>::iterator;
+
+    bool FindInCacheLocked(int64_t pos, uint32_t length, std::vector<PageData> &hit);
+    int32_t CopyFromPages(int64_t pos, uint32_t length, const std::vector<PageData> &hit, uint8_t *dst) const;
+    void SaveToCacheLocked(int64_t pos, int32_t length, const uint8_t *src, bool sequential);
+    bool TakeGhostLocked(uint64_t index);
+    void AddGhostLocked(uint64_t index);
+    void EvictLocked();
+    int32_t GetPageValidSize(uint64_t index) const;
+
+    std::shared_ptr<IMediaDataSource> dataSrc_;
+    const int64_t size_;
+    std::mutex mutex_;
+    std::list<CachePage> pages_;
+    std::unordered_map<uint64_t, PageIter> pageMap_;
+    // pages read once by a sequential miss, admitted to the cache when they are read again
+    std::list<uint64_t> ghostPages_;
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> ghostMap_;
+    int64_t capacity_;
+    int64_t usedBytes_ = 0;
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+    uint64_t hitBytes_ = 0;
+    uint64_t missBytes_ = 0;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // MEDIA_DATA_SOURCE_CACHE_H
@@ -32,6 +32,8 @@ constexpr float SPEED_1_00_X = 1.00;
 constexpr float SPEED_1_25_X = 1.25;
 constexpr float SPEED_1_75_X = 1.75;
 constexpr float SPEED_2_00_X = 2.00;
+constexpr float SPEED_8_00_X = 8.00;
+constexpr float SPEED_16_00_X = 16.00;
 constexpr size_t MAX_URI_SIZE = 4096;
 constexpr uint64_t RING_BUFFER_MAX_SIZE = 5242880; // 5 * 1024 * 1024
 
@@ -76,26 +78,33 @@ int32_t PlayerEngineGstImpl::GetRealPath(const std::string &url, std::string &re
     return MSERR_OK;
 }
 
-int32_t PlayerEngineGstImpl::SetSource(const std::string &url)
+int32_t PlayerEngineGstImpl::FormatUrl(const std::string &url, std::string &formattedUrl) const
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(!url.empty(), MSERR_INVALID_VAL, "input url is empty!");
     CHECK_AND_RETURN_RET_LOG(url.length() <= MAX_URI_SIZE, MSERR_INVALID_VAL, "input url length is invalid!");
 
-    std::string realUriPath;
-    int32_t ret = MSERR_OK;
-
     if (IsFileUrl(url)) {
-        ret = GetRealPath(url, realUriPath);
+        std::string realUriPath;
+        int32_t ret = GetRealPath(url, realUriPath);
         if (ret != MSERR_OK) {
             return ret;
         }
-        url_ = "file://" + realUriPath;
+        formattedUrl = "file://" + realUriPath;
     } else {
-        url_ = url;
+        formattedUrl = url;
     }
+    return MSERR_OK;
+}
+
+int32_t PlayerEngineGstImpl::SetSource(const std::string &url)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    int32_t ret = FormatUrl(url, url_);
+    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
     MEDIA_LOGD("set player source: %{public}s", url_.c_str());
+    // start a gstplayer in the background until prepare, see GstPlayerInit.
+    GstPlayerPool::Inst().Warm();
     return ret;
 }
 
@@ -105,6 +114,7 @@ int32_t PlayerEngineGstImpl::SetSource(const std::shared_ptr<IMediaDataSource> &
     CHECK_AND_RETURN_RET_LOG(dataSrc != nullptr, MSERR_INVALID_VAL, "input dataSrc is empty!");
     appsrcWarp_ = GstAppsrcWarp::Create(dataSrc);
     CHECK_AND_RETURN_RET_LOG(appsrcWarp_ != nullptr, MSERR_NO_MEMORY, "new appsrcwarp failed!");
+    GstPlayerPool::Inst().Warm();
     return MSERR_OK;
 }
 
@@ -162,22 +172,6 @@ int32_t PlayerEngineGstImpl::PrepareAsync()
     return MSERR_OK;
 }
 
-void PlayerEngineGstImpl::PlayerLoop()
-{
-    MEDIA_LOGD("PlayerLoop in");
-    playerBuild_ = std::make_unique<GstPlayerBuild>();
-    CHECK_AND_RETURN_LOG(playerBuild_ != nullptr, "playerBuild_ is nullptr");
-
-    playerCtrl_ = playerBuild_->Build(producerSurface_);
-    CHECK_AND_RETURN_LOG(playerCtrl_ != nullptr, "playerCtrl_ is nullptr");
-
-    condVarSync_.notify_all();
-
-    MEDIA_LOGD("Start the player loop");
-    playerBuild_->CreateLoop();
-    MEDIA_LOGD("Stop the player loop");
-}
-
 int32_t PlayerEngineGstImpl::GstPlayerInit()
 {
     if (gstPlayerInit_) {
@@ -185,19 +179,13 @@ int32_t PlayerEngineGstImpl::GstPlayerInit()
     }
 
     MEDIA_LOGD("GstPlayerInit in");
-    playerThread_.reset(new(std::nothrow) std::thread(&PlayerEngineGstImpl::PlayerLoop, this));
-    CHECK_AND_RETURN_RET_LOG(playerThread_ != nullptr, MSERR_NO_MEMORY, "new std::thread failed.");
-
-    if (!playerCtrl_) {
-        MEDIA_LOGD("Player not yet initialized, wait for 1 second");
-        std::unique_lock<std::mutex> lockSync(mutexSync_);
-        (void)condVarSync_.wait_for(lockSync, std::chrono::seconds(1));
-        if (playerCtrl_ == nullptr) {
-            MEDIA_LOGE("gstplayer initialized failed");
-            GstPlayerDeInit();
-            return MSERR_INVALID_VAL;
-        }
+    playerShell_ = GstPlayerPool::Inst().Acquire();
+    CHECK_AND_RETURN_RET_LOG(playerShell_ != nullptr, MSERR_INVALID_VAL, "gstplayer initialized failed");
+
+    if (producerSurface_ != nullptr) {
+        playerShell_->SetSurface(producerSurface_);
     }
+    playerCtrl_ = playerShell_->GetCtrl();
 
     int ret = GstPlayerPrepare();
     if (ret != MSERR_OK) {
@@ -206,8 +194,6 @@ int32_t PlayerEngineGstImpl::GstPlayerInit()
         return MSERR_INVALID_VAL;
     }
 
-    playerBuild_->WaitMainLoopStart();
-
     MEDIA_LOGD("GstPlayerInit out");
     gstPlayerInit_ = true;
     return MSERR_OK;
@@ -215,16 +201,10 @@ int32_t PlayerEngineGstImpl::GstPlayerInit()
 
 void PlayerEngineGstImpl::GstPlayerDeInit()
 {
-    if (playerBuild_ != nullptr) {
-        playerBuild_->DestroyLoop();
-    }
-
-    if (playerThread_ != nullptr && playerThread_->joinable()) {
-        playerThread_->join();
-    }
-
     playerCtrl_ = nullptr;
-    playerBuild_ = nullptr;
+    if (playerShell_ != nullptr) {
+        GstPlayerPool::Inst().Recycle(std::move(playerShell_));
+    }
     gstPlayerInit_ = false;
     appsrcWarp_ = nullptr;
 }
@@ -320,6 +300,18 @@ double PlayerEngineGstImpl::ChangeModeToSpeed(const PlaybackRateMode &mode) cons
     if (mode == SPEED_FORWARD_2_00_X) {
         return SPEED_2_00_X;
     }
+    if (mode == SPEED_FORWARD_8_00_X) {
+        return SPEED_8_00_X;
+    }
+    if (mode == SPEED_FORWARD_16_00_X) {
+        return SPEED_16_00_X;
+    }
+    if (mode == SPEED_BACKWARD_8_00_X) {
+        return -SPEED_8_00_X;
+    }
+    if (mode == SPEED_BACKWARD_16_00_X) {
+        return -SPEED_16_00_X;
+    }
 
     MEDIA_LOGW("unknow mode:%{public}d, return default speed(SPEED_1_00_X)", mode);
 
@@ -343,6 +335,18 @@ PlaybackRateMode PlayerEngineGstImpl::ChangeSpeedToMode(double rate) const
     if (abs(rate - SPEED_2_00_X) < EPSINON) {
         return SPEED_FORWARD_2_00_X;
     }
+    if (abs(rate - SPEED_8_00_X) < EPSINON) {
+        return SPEED_FORWARD_8_00_X;
+    }
+    if (abs(rate - SPEED_16_00_X) < EPSINON) {
+        return SPEED_FORWARD_16_00_X;
+    }
+    if (abs(rate + SPEED_8_00_X) < EPSINON) {
+        return SPEED_BACKWARD_8_00_X;
+    }
+    if (abs(rate + SPEED_16_00_X) < EPSINON) {
+        return SPEED_BACKWARD_16_00_X;
+    }
 
     MEDIA_LOGW("unknow rate:%{public}lf, return default speed(SPEED_FORWARD_1_00_X)", rate);
 
@@ -379,6 +383,28 @@ int32_t PlayerEngineGstImpl::SetLooping(bool loop)
     return MSERR_OK;
 }
 
+int32_t PlayerEngineGstImpl::SetNextSource(const std::string &url)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(playerCtrl_ != nullptr, MSERR_INVALID_OPERATION, "playerCtrl_ is nullptr");
+    CHECK_AND_RETURN_RET_LOG(appsrcWarp_ == nullptr, MSERR_INVALID_OPERATION, "not support for data source");
+
+    std::string nextUrl;
+    int32_t ret = FormatUrl(url, nextUrl);
+    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+
+    MEDIA_LOGD("set player next source: %{public}s", nextUrl.c_str());
+    return playerCtrl_->SetNextUrl(nextUrl);
+}
+
+int32_t PlayerEngineGstImpl::SetParameter(const Format &param)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(appsrcWarp_ != nullptr, MSERR_INVALID_OPERATION,
+        "the parameters only apply to the media data source");
+    return appsrcWarp_->SetParameter(param);
+}
+
 int32_t PlayerEngineGstImpl::Stop()
 {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -18,12 +18,11 @@
 
 #include <mutex>
 #include <cstdint>
-#include <thread>
 #include <map>
 
 #include "i_player_engine.h"
-#include "gst_player_build.h"
 #include "gst_player_ctrl.h"
+#include "gst_player_pool.h"
 #include "gst_appsrc_warp.h"
 
 namespace OHOS {
@@ -51,26 +50,25 @@ public:
     int32_t SetPlaybackSpeed(PlaybackRateMode mode) override;
     int32_t GetPlaybackSpeed(PlaybackRateMode &mode) override;
     int32_t SetLooping(bool loop) override;
+    int32_t SetNextSource(const std::string &url) override;
+    int32_t SetParameter(const Format &param) override;
 
 private:
     double ChangeModeToSpeed(const PlaybackRateMode &mode) const;
     PlaybackRateMode ChangeSpeedToMode(double rate) const;
     int32_t GstPlayerInit();
     int32_t GstPlayerPrepare() const;
-    void PlayerLoop();
     void GstPlayerDeInit();
     int32_t GetRealPath(const std::string &url, std::string &realUrlPath) const;
+    int32_t FormatUrl(const std::string &url, std::string &formattedUrl) const;
     bool IsFileUrl(const std::string &url) const;
     std::mutex mutex_;
-    std::mutex mutexSync_;
-    std::unique_ptr<GstPlayerBuild> playerBuild_ = nullptr;
+    std::unique_ptr<GstPlayerShell> playerShell_ = nullptr;
     std::shared_ptr<GstPlayerCtrl> playerCtrl_ = nullptr;
     std::weak_ptr<IPlayerEngineObs> obs_;
     sptr<Surface> producerSurface_ = nullptr;
     std::string url_ = "";
-    std::condition_variable condVarSync_;
     bool gstPlayerInit_ = false;
-    std::unique_ptr<std::thread> playerThread_;
     std::shared_ptr<GstAppsrcWarp> appsrcWarp_ = nullptr;
 };
 } // Media
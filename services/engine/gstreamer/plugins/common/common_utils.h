@@ -26,6 +26,8 @@ struct VideoFrameBuffer {
     uint64_t duration;
     uint64_t size;
     GstBuffer *gstBuffer;
+    uint32_t width; // 0 if unknown
+    uint32_t height; // 0 if unknown
 };
 
 struct EsAvcCodecBuffer {
@@ -33,6 +35,12 @@ struct EsAvcCodecBuffer {
     uint32_t height;
     uint64_t segmentStart;
     GstBuffer *gstCodecBuffer;
+    // from the sps, 0 if unknown
+    uint32_t profileIdc;
+    uint32_t constraintFlags;
+    uint32_t levelIdc;
+    uint32_t frameRateNum;
+    uint32_t frameRateDen;
 };
 
 enum VideoStreamType {
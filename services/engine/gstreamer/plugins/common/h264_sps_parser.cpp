@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "h264_sps_parser.h"
+#include <vector>
+
+namespace {
+    constexpr uint8_t NAL_TYPE_SPS = 7;
+    constexpr uint8_t NAL_TYPE_MASK = 0x1F;
+    constexpr uint32_t MB_SIZE = 16;
+    constexpr uint32_t MAX_UE_LEADING_ZEROS = 31;
+    constexpr uint32_t CHROMA_FORMAT_444 = 3;
+    constexpr uint32_t SCALING_LIST_COUNT = 8;
+    constexpr uint32_t SCALING_LIST_COUNT_444 = 12;
+    constexpr uint32_t SCALING_LIST_4X4_COUNT = 6;
+    constexpr uint32_t SCALING_LIST_4X4_SIZE = 16;
+    constexpr uint32_t SCALING_LIST_8X8_SIZE = 64;
+    constexpr uint32_t ASPECT_RATIO_EXTENDED_SAR = 255;
+    constexpr uint32_t MAX_CROPPED_SIZE = 16384;
+
+    // the profiles carrying chroma_format_idc and the bit depths, see 7.3.2.1.1
+    bool HasChromaInfo(uint32_t profileIdc)
+    {
+        switch (profileIdc) {
+            // high, high 10, high 4:2:2, high 4:4:4, cavlc 4:4:4 and the scalable, multiview and 3d ones
+            case 100: case 110: case 122: case 244: case 44:
+            case 83: case 86: case 118: case 128: case 138: case 139: case 134: case 135:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    class BitReader {
+    public:
+        BitReader(const uint8_t *data, size_t size)
+        {
+            // drop the emulation prevention bytes, 0x000003 is stored for 0x0000.
+            rbsp_.reserve(size);
+            uint32_t zeros = 0;
+            for (size_t i = 0; i < size; i++) {
+                if (zeros >= 2 && data[i] == 0x03) {
+                    zeros = 0;
+                    continue;
+                }
+                zeros = (data[i] == 0x00) ? zeros + 1 : 0;
+                rbsp_.push_back(data[i]);
+            }
+        }
+        ~BitReader() = default;
+
+        bool ReadBits(uint32_t count, uint32_t &value)
+        {
+            value = 0;
+            for (uint32_t i = 0; i < count; i++) {
+                if (pos_ >= rbsp_.size() * 8) { // 8 bits per byte
+                    return false;
+                }
+                uint32_t bit = (rbsp_[pos_ / 8] >> (7 - pos_ % 8)) & 0x01; // 8 bits per byte, msb first
+                value = (value << 1) | bit;
+                pos_++;
+            }
+            return true;
+        }
+
+        bool ReadUe(uint32_t &value)
+        {
+            uint32_t leadingZeros = 0;
+            uint32_t bit = 0;
+            while (true) {
+                if (!ReadBits(1, bit)) {
+                    return false;
+                }
+                if (bit == 1) {
+                    break;
+                }
+                if (++leadingZeros > MAX_UE_LEADING_ZEROS) {
+                    return false;
+                }
+            }
+            uint32_t suffix = 0;
+            if (!ReadBits(leadingZeros, suffix)) {
+                return false;
+            }
+            value = static_cast<uint32_t>((1ULL << leadingZeros) - 1 + suffix);
+            return true;
+        }
+
+        bool ReadSe(int32_t &value)
+        {
+            uint32_t codeNum = 0;
+            if (!ReadUe(codeNum)) {
+                return false;
+            }
+            // 1, 2, 3, 4 ... are mapped to 1, -1, 2, -2 ...
+            int64_t magnitude = (static_cast<int64_t>(codeNum) + 1) / 2;
+            value = static_cast<int32_t>((codeNum % 2 == 1) ? magnitude : -magnitude);
+            return true;
+        }
+
+        bool Skip(uint32_t count)
+        {
+            uint32_t value = 0;
+            while (count > MAX_UE_LEADING_ZEROS) {
+                if (!ReadBits(MAX_UE_LEADING_ZEROS, value)) {
+                    return false;
+                }
+                count -= MAX_UE_LEADING_ZEROS;
+            }
+            return ReadBits(count, value);
+        }
+
+    private:
+        std::vector<uint8_t> rbsp_;
+        size_t pos_ = 0;
+    };
+
+    bool SkipScalingList(BitReader &reader, uint32_t size)
+    {
+        int32_t lastScale = 8; // the default scale, see 7.3.2.1.1.1
+        int32_t nextScale = 8;
+        for (uint32_t i = 0; i < size; i++) {
+            if (nextScale != 0) {
+                int32_t deltaScale = 0;
+                if (!reader.ReadSe(deltaScale)) {
+                    return false;
+                }
+                nextScale = (lastScale + deltaScale + 256) % 256; // scales are in [0, 255]
+            }
+            lastScale = (nextScale == 0) ? lastScale : nextScale;
+        }
+        return true;
+    }
+
+    bool ParseChromaInfo(BitReader &reader, OHOS::Media::H264SpsInfo &info, uint32_t &chromaArrayType)
+    {
+        uint32_t value = 0;
+        if (!reader.ReadUe(info.chromaFormatIdc)) {
+            return false;
+        }
+        chromaArrayType = info.chromaFormatIdc;
+        if (info.chromaFormatIdc == CHROMA_FORMAT_444) {
+            uint32_t separateColourPlane = 0;
+            if (!reader.ReadBits(1, separateColourPlane)) {
+                return false;
+            }
+            if (separateColourPlane == 1) {
+                chromaArrayType = 0; // coded as monochrome planes
+            }
+        }
+        // bit_depth_luma_minus8, bit_depth_chroma_minus8, qpprime_y_zero_transform_bypass_flag
+        if (!reader.ReadUe(value) || !reader.ReadUe(value) || !reader.Skip(1)) {
+            return false;
+        }
+        uint32_t scalingMatrixPresent = 0;
+        if (!reader.ReadBits(1, scalingMatrixPresent)) {
+            return false;
+        }
+        if (scalingMatrixPresent == 0) {
+            return true;
+        }
+        uint32_t count = (info.chromaFormatIdc == CHROMA_FORMAT_444) ? SCALING_LIST_COUNT_444 : SCALING_LIST_COUNT;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t listPresent = 0;
+            if (!reader.ReadBits(1, listPresent)) {
+                return false;
+            }
+            uint32_t size = (i < SCALING_LIST_4X4_COUNT) ? SCALING_LIST_4X4_SIZE : SCALING_LIST_8X8_SIZE;
+            if (listPresent == 1 && !SkipScalingList(reader, size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool SkipPicOrderCnt(BitReader &reader)
+    {
+        uint32_t value = 0;
+        int32_t offset = 0;
+        uint32_t picOrderCntType = 0;
+        if (!reader.ReadUe(picOrderCntType)) {
+            return false;
+        }
+        if (picOrderCntType == 0) {
+            return reader.ReadUe(value); // log2_max_pic_order_cnt_lsb_minus4
+        }
+        if (picOrderCntType == 1) {
+            // delta_pic_order_always_zero_flag, offset_for_non_ref_pic, offset_for_top_to_bottom_field
+            uint32_t cycle = 0;
+            if (!reader.Skip(1) || !reader.ReadSe(offset) || !reader.ReadSe(offset) || !reader.ReadUe(cycle)) {
+                return false;
+            }
+            for (uint32_t i = 0; i < cycle; i++) {
+                if (!reader.ReadSe(offset)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool ParseTimingInfo(BitReader &reader, OHOS::Media::H264SpsInfo &info)
+    {
+        uint32_t value = 0;
+        uint32_t present = 0;
+        // aspect_ratio_info_present_flag
+        if (!reader.ReadBits(1, present)) {
+            return false;
+        }
+        if (present == 1) {
+            if (!reader.ReadBits(8, value)) { // aspect_ratio_idc, 8 bits
+                return false;
+            }
+            if (value == ASPECT_RATIO_EXTENDED_SAR && !reader.Skip(32)) { // sar_width and sar_height, 16 bits each
+                return false;
+            }
+        }
+        // overscan_info_present_flag
+        if (!reader.ReadBits(1, present) || (present == 1 && !reader.Skip(1))) {
+            return false;
+        }
+        // video_signal_type_present_flag
+        if (!reader.ReadBits(1, present)) {
+            return false;
+        }
+        if (present == 1) {
+            // video_format 3 bits, video_full_range_flag 1 bit, colour_description_present_flag
+            uint32_t colourDescription = 0;
+            if (!reader.Skip(4) || !reader.ReadBits(1, colourDescription)) {
+                return false;
+            }
+            if (colourDescription == 1 && !reader.Skip(24)) { // 3 bytes of the colour description
+                return false;
+            }
+        }
+        // chroma_loc_info_present_flag
+        if (!reader.ReadBits(1, present)) {
+            return false;
+        }
+        if (present == 1 && (!reader.ReadUe(value) || !reader.ReadUe(value))) {
+            return false;
+        }
+        // timing_info_present_flag
+        if (!reader.ReadBits(1, present) || present == 0) {
+            return false;
+        }
+        uint32_t numUnitsInTick = 0;
+        uint32_t timeScale = 0;
+        if (!reader.ReadBits(32, numUnitsInTick) || !reader.ReadBits(32, timeScale) || // 32 bits each
+            numUnitsInTick == 0 || numUnitsInTick > UINT32_MAX / 2) {
+            return false;
+        }
+        // a frame lasts two ticks, one for each field
+        info.frameRateNum = timeScale;
+        info.frameRateDen = numUnitsInTick * 2;
+        return true;
+    }
+}
+
+namespace OHOS {
+namespace Media {
+bool H264SpsParser::Parse(const uint8_t *data, size_t size, H264SpsInfo &info)
+{
+    if (data == nullptr || size < 4 || (data[0] & NAL_TYPE_MASK) != NAL_TYPE_SPS) { // header and 3 bytes at least
+        return false;
+    }
+
+    BitReader reader(data + 1, size - 1);
+    uint32_t value = 0;
+    H264SpsInfo sps;
+    // profile_idc, constraint_set flags and reserved_zero_2bits, level_idc
+    if (!reader.ReadBits(8, sps.profileIdc) || !reader.ReadBits(8, sps.constraintFlags) || // 8 bits
+        !reader.ReadBits(8, sps.levelIdc) || !reader.ReadUe(value)) { // 8 bits, seq_parameter_set_id
+        return false;
+    }
+    // ChromaArrayType, which differs from chroma_format_idc if the colour planes are coded separately
+    uint32_t chromaArrayType = sps.chromaFormatIdc;
+    if (HasChromaInfo(sps.profileIdc) && !ParseChromaInfo(reader, sps, chromaArrayType)) {
+        return false;
+    }
+    // log2_max_frame_num_minus4
+    if (!reader.ReadUe(value) || !SkipPicOrderCnt(reader)) {
+        return false;
+    }
+    // max_num_ref_frames, gaps_in_frame_num_value_allowed_flag
+    uint32_t widthInMbs = 0;
+    uint32_t heightInMapUnits = 0;
+    uint32_t frameMbsOnly = 0;
+    if (!reader.ReadUe(value) || !reader.Skip(1) || !reader.ReadUe(widthInMbs) ||
+        !reader.ReadUe(heightInMapUnits) || !reader.ReadBits(1, frameMbsOnly)) {
+        return false;
+    }
+    // mb_adaptive_frame_field_flag, direct_8x8_inference_flag
+    if ((frameMbsOnly == 0 && !reader.Skip(1)) || !reader.Skip(1)) {
+        return false;
+    }
+
+    uint32_t cropLeft = 0;
+    uint32_t cropRight = 0;
+    uint32_t cropTop = 0;
+    uint32_t cropBottom = 0;
+    uint32_t cropping = 0;
+    if (!reader.ReadBits(1, cropping)) {
+        return false;
+    }
+    if (cropping == 1 && (!reader.ReadUe(cropLeft) || !reader.ReadUe(cropRight) ||
+        !reader.ReadUe(cropTop) || !reader.ReadUe(cropBottom))) {
+        return false;
+    }
+
+    uint64_t width = (static_cast<uint64_t>(widthInMbs) + 1) * MB_SIZE;
+    uint64_t height = (static_cast<uint64_t>(heightInMapUnits) + 1) * MB_SIZE * (2 - frameMbsOnly);
+    // the crop units in the luma samples, see table 6-1
+    uint64_t cropUnitX = (chromaArrayType == 1 || chromaArrayType == 2) ? 2 : 1;
+    uint64_t cropUnitY = ((chromaArrayType == 1) ? 2 : 1) * (2 - frameMbsOnly);
+    uint64_t cropX = cropUnitX * (static_cast<uint64_t>(cropLeft) + cropRight);
+    uint64_t cropY = cropUnitY * (static_cast<uint64_t>(cropTop) + cropBottom);
+    if (width > MAX_CROPPED_SIZE || height > MAX_CROPPED_SIZE || cropX >= width || cropY >= height) {
+        return false;
+    }
+    sps.width = static_cast<uint32_t>(width - cropX);
+    sps.height = static_cast<uint32_t>(height - cropY);
+
+    uint32_t vuiPresent = 0;
+    if (reader.ReadBits(1, vuiPresent) && vuiPresent == 1 && !ParseTimingInfo(reader, sps)) {
+        sps.frameRateNum = 0; // the frame rate is optional, keep the rest
+        sps.frameRateDen = 1;
+    }
+
+    info = sps;
+    return true;
+}
+} // Media
+} // OHOS
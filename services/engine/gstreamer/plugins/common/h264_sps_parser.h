@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef H264_SPS_PARSER_H
+#define H264_SPS_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace Media {
+struct H264SpsInfo {
+    uint32_t profileIdc = 0;
+    uint32_t constraintFlags = 0; // constraint_set0_flag at the most significant bit
+    uint32_t levelIdc = 0;
+    uint32_t chromaFormatIdc = 1;
+    uint32_t width = 0; // after cropping
+    uint32_t height = 0; // after cropping
+    uint32_t frameRateNum = 0; // 0 if the vui has no timing info
+    uint32_t frameRateDen = 1;
+};
+
+class H264SpsParser {
+public:
+    H264SpsParser() = delete;
+    ~H264SpsParser() = delete;
+
+    /**
+     * Parse the sequence parameter set. The data starts with the nal header, without the start
+     * code, and may still contain the emulation prevention bytes.
+     */
+    static bool Parse(const uint8_t *data, size_t size, H264SpsInfo &info);
+};
+} // Media
+} // OHOS
+#endif // H264_SPS_PARSER_H
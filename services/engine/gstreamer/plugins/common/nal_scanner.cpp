@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nal_scanner.h"
+#include <cstring>
+// NAL_SCANNER_NO_SIMD forces the word-at-a-time path, so that it can be tested on any target.
+#if defined(__SSE2__) && !defined(NAL_SCANNER_NO_SIMD)
+#define NAL_SCANNER_SSE2
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(NAL_SCANNER_NO_SIMD)
+#define NAL_SCANNER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+    constexpr uint32_t SHORT_START_CODE_SIZE = 3;
+    constexpr uint32_t LONG_START_CODE_SIZE = 4;
+    constexpr uint32_t H264_NAL_HEADER_SIZE = 1;
+    constexpr uint32_t H265_NAL_HEADER_SIZE = 2;
+    constexpr uint8_t H264_NAL_TYPE_MASK = 0x1F;
+    constexpr uint8_t H265_NAL_TYPE_MASK = 0x3F;
+    constexpr uint8_t H265_NAL_TYPE_SHIFT = 1;
+#if defined(NAL_SCANNER_SSE2) || defined(NAL_SCANNER_NEON)
+    constexpr size_t BLOCK_SIZE = 16;
+#else
+    constexpr size_t BLOCK_SIZE = sizeof(uint64_t);
+    constexpr uint64_t LOW_BITS = 0x0101010101010101ULL;
+    constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+#endif
+
+    // a start code can only begin at a zero byte, so the blocks without any are skipped as a whole.
+    inline bool HasZeroByte(const uint8_t *block)
+    {
+#if defined(NAL_SCANNER_SSE2)
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_setzero_si128())) != 0;
+#elif defined(NAL_SCANNER_NEON)
+        uint64x2_t eq = vreinterpretq_u64_u8(vceqq_u8(vld1q_u8(block), vdupq_n_u8(0)));
+        return (vgetq_lane_u64(eq, 0) | vgetq_lane_u64(eq, 1)) != 0;
+#else
+        uint64_t word;
+        (void)memcpy(&word, block, sizeof(word));
+        return ((word - LOW_BITS) & ~word & HIGH_BITS) != 0;
+#endif
+    }
+
+    // returns the first 0x000001 with its 0x01 before end.
+    const uint8_t *FindShortStartCode(const uint8_t *begin, const uint8_t *end)
+    {
+        if (end - begin < static_cast<ptrdiff_t>(SHORT_START_CODE_SIZE)) {
+            return end;
+        }
+        const uint8_t *last = end - SHORT_START_CODE_SIZE;
+        const uint8_t *cur = begin;
+        while (cur <= last) {
+            if (static_cast<size_t>(end - cur) >= BLOCK_SIZE && !HasZeroByte(cur)) {
+                cur += BLOCK_SIZE;
+                continue;
+            }
+            const uint8_t *blockEnd = cur + BLOCK_SIZE;
+            for (; cur <= last && cur < blockEnd; cur++) {
+                if (cur[0] == 0x00 && cur[1] == 0x00 && cur[2] == 0x01) {
+                    return cur;
+                }
+            }
+        }
+        return end;
+    }
+}
+
+namespace OHOS {
+namespace Media {
+const uint8_t *NalScanner::FindStartCode(const uint8_t *begin, const uint8_t *end, uint32_t &startCodeSize)
+{
+    if (begin == nullptr || end == nullptr || begin >= end) {
+        return end;
+    }
+
+    const uint8_t *pos = FindShortStartCode(begin, end);
+    if (pos == end) {
+        return end;
+    }
+    // a 0x00000001 always contains a 0x000001, so the earliest one is found just before it.
+    if (pos > begin && pos[-1] == 0x00) {
+        startCodeSize = LONG_START_CODE_SIZE;
+        return pos - 1;
+    }
+    startCodeSize = SHORT_START_CODE_SIZE;
+    return pos;
+}
+
+bool NalScanner::NextNalUnit(const uint8_t *begin, const uint8_t *end, NalCodecType codec, NalUnit &nal)
+{
+    uint32_t startCodeSize = 0;
+    const uint8_t *start = FindStartCode(begin, end, startCodeSize);
+    if (start == end) {
+        return false;
+    }
+
+    const uint8_t *header = start + startCodeSize;
+    if (static_cast<size_t>(end - header) < GetNalHeaderSize(codec)) {
+        return false;
+    }
+
+    uint32_t nextStartCodeSize = 0;
+    nal.start = start;
+    nal.header = header;
+    nal.end = FindStartCode(header, end, nextStartCodeSize);
+    nal.startCodeSize = startCodeSize;
+    nal.type = GetNalType(header, codec);
+    return true;
+}
+
+uint32_t NalScanner::GetNalType(const uint8_t *header, NalCodecType codec)
+{
+    if (header == nullptr) {
+        return 0;
+    }
+    if (codec == NAL_CODEC_H265) {
+        return (header[0] >> H265_NAL_TYPE_SHIFT) & H265_NAL_TYPE_MASK;
+    }
+    return header[0] & H264_NAL_TYPE_MASK;
+}
+
+uint32_t NalScanner::GetNalHeaderSize(NalCodecType codec)
+{
+    return codec == NAL_CODEC_H265 ? H265_NAL_HEADER_SIZE : H264_NAL_HEADER_SIZE;
+}
+} // Media
+} // OHOS
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NAL_SCANNER_H
+#define NAL_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace Media {
+enum NalCodecType : int32_t {
+    NAL_CODEC_H264,
+    NAL_CODEC_H265,
+};
+
+struct NalUnit {
+    const uint8_t *start = nullptr; // the first byte of the start code
+    const uint8_t *header = nullptr; // the first byte of the nal header, following the start code
+    const uint8_t *end = nullptr; // the start code of the next nal unit, or the end of the data
+    uint32_t startCodeSize = 0;
+    uint32_t type = 0;
+};
+
+/**
+ * Scans the annex-b byte streams for the start codes 0x000001 and 0x00000001. The bytes are
+ * tested 16 at a time with SSE2 or NEON where available, or a word at a time otherwise, and
+ * only the blocks containing a zero byte are checked byte by byte.
+ */
+class NalScanner {
+public:
+    NalScanner() = delete;
+    ~NalScanner() = delete;
+
+    /**
+     * Find the first start code in [begin, end). Returns end if not found, otherwise the first
+     * zero byte of the start code, and startCodeSize is set to 3 or 4.
+     */
+    static const uint8_t *FindStartCode(const uint8_t *begin, const uint8_t *end, uint32_t &startCodeSize);
+
+    /**
+     * Find the first nal unit at or after begin. Returns false if there is no start code, or the
+     * start code is not followed by a complete nal header.
+     */
+    static bool NextNalUnit(const uint8_t *begin, const uint8_t *end, NalCodecType codec, NalUnit &nal);
+
+    static uint32_t GetNalType(const uint8_t *header, NalCodecType codec);
+    static uint32_t GetNalHeaderSize(NalCodecType codec);
+};
+} // Media
+} // OHOS
+#endif // NAL_SCANNER_H
@@ -50,11 +50,11 @@ struct _GstAudioServerSink {
     gfloat min_volume;
     guint min_buffer_size;
     guint min_frame_count;
-    GstBuffer *cache_buffer;
+    guint8 *cache_data;
     guint cache_size;
+    guint cache_capacity;
     gboolean enable_cache;
     gboolean frame_after_segment;
-    GMutex render_lock;
     std::mutex mutex_;
     GstBuffer *pause_cache_buffer;
     gboolean is_start;
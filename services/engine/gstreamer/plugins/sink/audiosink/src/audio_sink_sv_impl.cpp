@@ -264,7 +264,14 @@ bool AudioSinkSvImpl::Writeable() const
 int32_t AudioSinkSvImpl::Write(uint8_t *buffer, size_t size)
 {
     CHECK_AND_RETURN_RET(audioRenderer_ != nullptr, MSERR_INVALID_OPERATION);
-    CHECK_AND_RETURN_RET(audioRenderer_->Write(buffer, size) > 0, MSERR_UNKNOWN);
+    CHECK_AND_RETURN_RET(buffer != nullptr, MSERR_INVALID_VAL);
+    // the renderer may accept less than requested, keep writing the rest rather than dropping it.
+    size_t written = 0;
+    while (written < size) {
+        int32_t ret = audioRenderer_->Write(buffer + written, size - written);
+        CHECK_AND_RETURN_RET(ret > 0, MSERR_UNKNOWN);
+        written += static_cast<size_t>(ret);
+    }
     return MSERR_OK;
 }
 
@@ -18,6 +18,7 @@
 #include <cinttypes>
 #include <gst/gst.h>
 #include "gst/audio/audio.h"
+#include "securec.h"
 #include "media_errors.h"
 #include "audio_sink_factory.h"
 
@@ -44,6 +45,7 @@ enum {
     PROP_VOLUME,
     PROP_MAX_VOLUME,
     PROP_MIN_VOLUME,
+    PROP_ENABLE_CACHE,
 };
 
 #define gst_audio_server_sink_parent_class parent_class
@@ -60,6 +62,7 @@ static gboolean gst_audio_server_sink_start(GstBaseSink *basesink);
 static gboolean gst_audio_server_sink_stop(GstBaseSink *basesink);
 static GstFlowReturn gst_audio_server_sink_render(GstBaseSink *basesink, GstBuffer *buffer);
 static void gst_audio_server_sink_clear_cache_buffer(GstAudioServerSink *sink);
+static gboolean gst_audio_server_sink_write_cache(GstAudioServerSink *sink);
 
 static void gst_audio_server_sink_class_init(GstAudioServerSinkClass *klass)
 {
@@ -102,6 +105,11 @@ static void gst_audio_server_sink_class_init(GstAudioServerSinkClass *klass)
             "Minimum Volume", 0, G_MAXFLOAT, 0,
             (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
 
+    g_object_class_install_property(gobject_class, PROP_ENABLE_CACHE,
+        g_param_spec_boolean("enable-cache", "Enable Cache",
+            "Accumulate small buffers up to the minimum buffer size before writing them", FALSE,
+            (GParamFlags)(G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY | G_PARAM_STATIC_STRINGS)));
+
     gst_element_class_set_static_metadata(gstelement_class,
         "Audio server sink", "Sink/Audio",
         "Push pcm data to Audio server", "OpenHarmony");
@@ -130,13 +138,13 @@ static void gst_audio_server_sink_init(GstAudioServerSink *sink)
     sink->min_volume = 0;
     sink->min_buffer_size = 0;
     sink->min_frame_count = 0;
-    sink->cache_buffer = nullptr;
+    sink->cache_data = nullptr;
     sink->pause_cache_buffer = nullptr;
     sink->cache_size = 0;
+    sink->cache_capacity = 0;
     sink->enable_cache = FALSE;
     sink->frame_after_segment = FALSE;
     sink->is_start = FALSE;
-    g_mutex_init(&sink->render_lock);
 }
 
 static void gst_audio_server_sink_finalize(GObject *object)
@@ -146,12 +154,15 @@ static void gst_audio_server_sink_finalize(GObject *object)
     g_return_if_fail(sink != nullptr);
     GST_INFO_OBJECT(sink, "gst_audio_server_sink_finalize in");
 
-    g_mutex_clear(&sink->render_lock);
     if (sink->audio_sink != nullptr) {
         (void)sink->audio_sink->Release();
         sink->audio_sink = nullptr;
     }
     gst_audio_server_sink_clear_cache_buffer(sink);
+    g_free(sink->cache_data);
+    sink->cache_data = nullptr;
+    sink->cache_size = 0;
+    sink->cache_capacity = 0;
 }
 
 static gboolean gst_audio_server_sink_set_volume(GstAudioServerSink *sink, gfloat volume)
@@ -186,6 +197,14 @@ static void gst_audio_server_sink_set_property(GObject *object, guint prop_id,
                 g_object_notify(G_OBJECT(sink), "volume");
             }
             break;
+        case PROP_ENABLE_CACHE:
+            // switching in the middle of a stream would reorder the cached data with the direct writes.
+            if (GST_STATE(sink) > GST_STATE_READY) {
+                GST_WARNING_OBJECT(sink, "enable-cache can only be changed in the null or ready state");
+                break;
+            }
+            sink->enable_cache = g_value_get_boolean(value);
+            break;
         default:
             break;
     }
@@ -220,6 +239,9 @@ static void gst_audio_server_sink_get_property(GObject *object, guint prop_id, G
         case PROP_MIN_VOLUME:
             g_value_set_float(value, sink->min_volume);
             break;
+        case PROP_ENABLE_CACHE:
+            g_value_set_boolean(value, sink->enable_cache);
+            break;
         default:
             break;
     }
@@ -253,6 +275,8 @@ static gboolean gst_audio_server_sink_set_caps(GstBaseSink *basesink, GstCaps *c
         return FALSE;
     }
     g_return_val_if_fail(channels > 0 && rate > 0, FALSE);
+    // the cached data is in the previous format, write it out before the parameters change.
+    g_return_val_if_fail(gst_audio_server_sink_write_cache(sink) == TRUE, FALSE);
     sink->sample_rate = static_cast<uint32_t>(rate);
     sink->channels = static_cast<uint32_t>(channels);
     g_return_val_if_fail(sink->audio_sink->SetParameters(sink->bits_per_sample, sink->channels,
@@ -264,6 +288,18 @@ static gboolean gst_audio_server_sink_set_caps(GstBaseSink *basesink, GstCaps *c
     g_return_val_if_fail(sink->audio_sink->GetMinimumBufferSize(sink->min_buffer_size) == MSERR_OK, FALSE);
     g_return_val_if_fail(sink->audio_sink->GetMinimumFrameCount(sink->min_frame_count) == MSERR_OK, FALSE);
 
+    // the cache holds exactly one minimum buffer, it is written out as soon as it is full.
+    if (sink->enable_cache && sink->cache_capacity != sink->min_buffer_size) {
+        g_free(sink->cache_data);
+        sink->cache_data = static_cast<guint8 *>(g_malloc(sink->min_buffer_size));
+        sink->cache_capacity = sink->min_buffer_size;
+    } else if (!sink->enable_cache && sink->cache_data != nullptr) {
+        g_free(sink->cache_data);
+        sink->cache_data = nullptr;
+        sink->cache_capacity = 0;
+    }
+    sink->cache_size = 0;
+
     return TRUE;
 }
 
@@ -279,14 +315,15 @@ static gboolean gst_audio_server_sink_event(GstBaseSink *basesink, GstEvent *eve
             if (sink->audio_sink == nullptr) {
                 break;
             }
+            if (gst_audio_server_sink_write_cache(sink) != TRUE) {
+                GST_ERROR_OBJECT(basesink, "fail to write the cached data when handling EOS event");
+            }
             if (sink->audio_sink->Drain() != MSERR_OK) {
                 GST_ERROR_OBJECT(basesink, "fail to call Drain when handling EOS event");
             }
             break;
         case GST_EVENT_SEGMENT:
-            g_mutex_lock(&sink->render_lock);
-            sink->frame_after_segment = TRUE;
-            g_mutex_unlock(&sink->render_lock);
+            g_atomic_int_set(&sink->frame_after_segment, TRUE);
             break;
         case GST_EVENT_FLUSH_START:
             gst_audio_server_sink_clear_cache_buffer(sink);
@@ -299,6 +336,7 @@ static gboolean gst_audio_server_sink_event(GstBaseSink *basesink, GstEvent *eve
             GST_DEBUG_OBJECT(basesink, "received FLUSH_START");
             break;
         case GST_EVENT_FLUSH_STOP:
+            sink->cache_size = 0; // serialized with the render, the flushed data is never written
             GST_DEBUG_OBJECT(basesink, "received FLUSH_STOP");
             break;
         default:
@@ -343,60 +381,58 @@ static gboolean gst_audio_server_sink_stop(GstBaseSink *basesink)
     return TRUE;
 }
 
+static gboolean gst_audio_server_sink_write_cache(GstAudioServerSink *sink)
+{
+    if (sink->cache_data == nullptr || sink->cache_size == 0) {
+        return TRUE;
+    }
+    guint size = sink->cache_size;
+    sink->cache_size = 0;
+    g_return_val_if_fail(sink->audio_sink->Write(sink->cache_data, size) == MSERR_OK, FALSE);
+    return TRUE;
+}
+
 static GstFlowReturn gst_audio_server_sink_cache_render(GstAudioServerSink *sink, GstBuffer *buffer)
 {
+    g_return_val_if_fail(sink->cache_data != nullptr && sink->cache_capacity > 0, GST_FLOW_ERROR);
     GstMapInfo map;
     if (gst_buffer_map(buffer, &map, GST_MAP_READ) != TRUE) {
         return GST_FLOW_ERROR;
     }
-    gsize size = map.size;
-
-    if (sink->cache_size == 0 && size >= sink->min_buffer_size) {
-        if (sink->audio_sink->Write(map.data, size) != MSERR_OK) {
-            gst_buffer_unmap(buffer, &map);
-            return GST_FLOW_ERROR;
-        }
-        gst_buffer_unmap(buffer, &map);
-        return GST_FLOW_OK;
-    }
-    gst_buffer_unmap(buffer, &map);
 
-    if (sink->cache_size == 0 && size < sink->min_buffer_size) {
-        sink->cache_size += static_cast<guint>(size);
-        sink->cache_buffer = gst_buffer_copy(buffer);
-        if (sink->cache_buffer == nullptr) {
-            return GST_FLOW_ERROR;
+    GstFlowReturn ret = GST_FLOW_OK;
+    guint8 *data = map.data;
+    gsize size = map.size;
+    while (size > 0) {
+        // bypass the cache when it is empty and the input is large enough to be written as it is.
+        if (sink->cache_size == 0 && size >= sink->cache_capacity) {
+            if (sink->audio_sink->Write(data, size) != MSERR_OK) {
+                ret = GST_FLOW_ERROR;
+            }
+            break;
         }
-        return GST_FLOW_OK;
-    }
 
-    sink->cache_size += static_cast<guint>(size);
-    GstBuffer *buf = gst_buffer_copy(sink->cache_buffer);
-    if (buf == nullptr) {
-        gst_buffer_unref(sink->cache_buffer);
-        return GST_FLOW_ERROR;
-    }
-    (void)gst_buffer_ref(buffer);
-    buf = gst_buffer_append(buf, buffer);
-    gst_buffer_unref(sink->cache_buffer);
-    sink->cache_buffer = buf;
-
-    if (sink->cache_size >= sink->min_buffer_size) {
-        if (gst_buffer_map(sink->cache_buffer, &map, GST_MAP_READ) != TRUE) {
-            gst_buffer_unref(sink->cache_buffer);
-            return GST_FLOW_ERROR;
+        gsize copy_size = MIN(size, static_cast<gsize>(sink->cache_capacity - sink->cache_size));
+        if (memcpy_s(sink->cache_data + sink->cache_size, sink->cache_capacity - sink->cache_size,
+            data, copy_size) != EOK) {
+            ret = GST_FLOW_ERROR;
+            break;
         }
-        int32_t ret = sink->audio_sink->Write(map.data, sink->cache_size);
-        gst_buffer_unmap(sink->cache_buffer, &map);
-        gst_buffer_unref(sink->cache_buffer);
-        sink->cache_size = 0;
-        sink->cache_buffer = nullptr;
-        if (ret != MSERR_OK) {
-            return GST_FLOW_ERROR;
+        sink->cache_size += static_cast<guint>(copy_size);
+        data += copy_size;
+        size -= copy_size;
+
+        if (sink->cache_size == sink->cache_capacity) {
+            sink->cache_size = 0;
+            if (sink->audio_sink->Write(sink->cache_data, sink->cache_capacity) != MSERR_OK) {
+                ret = GST_FLOW_ERROR;
+                break;
+            }
         }
-        return GST_FLOW_OK;
     }
-    return GST_FLOW_OK;
+
+    gst_buffer_unmap(buffer, &map);
+    return ret;
 }
 
 static GstStateChangeReturn gst_audio_server_sink_change_state(GstElement *element, GstStateChange transition)
@@ -457,10 +493,9 @@ static GstFlowReturn gst_audio_server_sink_render(GstBaseSink *basesink, GstBuff
     g_return_val_if_fail(sink->audio_sink != nullptr, GST_FLOW_ERROR);
 
     if (sink->enable_cache) {
-        return gst_audio_server_sink_cache_render(sink, buffer);
-    }
-
-    {
+        GstFlowReturn ret = gst_audio_server_sink_cache_render(sink, buffer);
+        g_return_val_if_fail(ret == GST_FLOW_OK, ret);
+    } else {
         std::unique_lock<std::mutex> lock(sink->mutex_);
         if (!sink->audio_sink->Writeable()) {
             if (sink->pause_cache_buffer == nullptr) {
@@ -486,9 +521,7 @@ static GstFlowReturn gst_audio_server_sink_render(GstBaseSink *basesink, GstBuff
         gst_buffer_unmap(buffer, &map);
     }
 
-    g_mutex_lock(&sink->render_lock);
-    if (sink->frame_after_segment) {
-        sink->frame_after_segment = FALSE;
+    if (g_atomic_int_compare_and_exchange(&sink->frame_after_segment, TRUE, FALSE)) {
         uint64_t latency = 0;
         GST_INFO_OBJECT(basesink, "the first audio frame after segment has been sent to audio server");
         if (sink->audio_sink->GetLatency(latency) != MSERR_OK) {
@@ -497,7 +530,6 @@ static GstFlowReturn gst_audio_server_sink_render(GstBaseSink *basesink, GstBuff
             GST_INFO_OBJECT(basesink, "frame render latency is (%" PRIu64 ")", latency);
         }
     }
-    g_mutex_unlock(&sink->render_lock);
 
     return GST_FLOW_OK;
 }
@@ -15,6 +15,8 @@
 
 #include "gst_video_shmem_pool.h"
 #include "gst_shmem_allocator.h"
+#include "gst_shmem_memory.h"
+#include "avsharedmemorybase.h"
 
 #define gst_video_shmem_pool_parent_class parent_class
 G_DEFINE_TYPE (GstVideoShMemPool, gst_video_shmem_pool, GST_TYPE_VIDEO_BUFFER_POOL);
@@ -41,6 +43,47 @@ static gboolean gst_video_shmem_pool_set_config(GstBufferPool *pool, GstStructur
     return GST_BUFFER_POOL_CLASS(parent_class)->set_config(pool, config);
 }
 
+static gboolean gst_video_shmem_pool_is_reusable(GstBuffer *buffer)
+{
+    guint num = gst_buffer_n_memory(buffer);
+    for (guint i = 0; i < num; i++) {
+        GstMemory *memory = gst_buffer_peek_memory(buffer, i);
+        if (memory == nullptr || !gst_is_shmem_memory(memory)) {
+            return FALSE;
+        }
+
+        /**
+         * The shared memory may be still referenced by the consumer besides the buffer, or may have been
+         * shared to the remote process that is still reading it, it can not be filled again. The remote
+         * process never acknowledges its release, so a memory once written to a parcel is never reused:
+         * only the frames consumed in this process, such as the batch fetch, are recycled, the single
+         * frame fetch returned to the client allocates a new memory each time.
+         */
+        GstShMemMemory *shmem = reinterpret_cast<GstShMemMemory *>(memory);
+        if (shmem->mem == nullptr || shmem->mem.use_count() > 1) {
+            return FALSE;
+        }
+        auto baseMem = std::static_pointer_cast<OHOS::Media::AVSharedMemoryBase>(shmem->mem);
+        if (baseMem->IsShared()) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+static void gst_video_shmem_pool_release_buffer(GstBufferPool *pool, GstBuffer *buffer)
+{
+    g_return_if_fail(pool != nullptr && buffer != nullptr);
+
+    if (!gst_video_shmem_pool_is_reusable(buffer)) {
+        GST_DEBUG_OBJECT(pool, "memory still in use, discard the buffer");
+        GST_BUFFER_FLAG_SET(buffer, GST_BUFFER_FLAG_TAG_MEMORY);
+    }
+
+    GST_BUFFER_POOL_CLASS(parent_class)->release_buffer(pool, buffer);
+}
+
 static void gst_video_shmem_pool_finalize(GObject *obj)
 {
     g_return_if_fail(obj != nullptr);
@@ -59,6 +102,7 @@ static void gst_video_shmem_pool_class_init (GstVideoShMemPoolClass *klass)
     gobjectClass->finalize = gst_video_shmem_pool_finalize;
     poolClass->get_options = gst_video_shmem_pool_get_options;
     poolClass->set_config = gst_video_shmem_pool_set_config;
+    poolClass->release_buffer = gst_video_shmem_pool_release_buffer;
 }
 
 static void gst_video_shmem_pool_init (GstVideoShMemPool *pool)
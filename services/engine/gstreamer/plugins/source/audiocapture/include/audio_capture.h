@@ -124,6 +124,14 @@ public:
      * @version 1.0
      */
     virtual std::shared_ptr<AudioBuffer> GetBuffer() = 0;
+
+    /**
+     * @brief Lock or UnLock any pending access to the resource.
+     *
+     * This function will be invoked when the source stops or resumes playing, so that a caller blocked
+     * in the {@link GetBuffer} can return and the streaming thread is able to stop.
+     */
+    virtual void UnLock(bool start) = 0;
 };
 }  // namespace Media
 }  // namespace OHOS
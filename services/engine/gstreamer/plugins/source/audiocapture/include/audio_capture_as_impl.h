@@ -16,6 +16,11 @@
 #ifndef AUDIO_CAPTURE_AS_IMPL_H
 #define AUDIO_CAPTURE_AS_IMPL_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "audio_capture.h"
 #include "audio_capturer.h"
 #include "nocopyable.h"
@@ -35,8 +40,21 @@ public:
     int32_t PauseAudioCapture() override;
     int32_t ResumeAudioCapture() override;
     std::shared_ptr<AudioBuffer> GetBuffer() override;
+    void UnLock(bool start) override;
 
 private:
+    static constexpr size_t RING_SIZE = 8;
+
+    int32_t CreateBufferPool();
+    void DestroyBufferPool();
+    int32_t StartCaptureThread();
+    void StopCaptureThread();
+    void CaptureLoop();
+    bool StampBuffer(GstBuffer *buffer, size_t size);
+    bool PushBuffer(GstBuffer *buffer);
+    GstBuffer *PopBuffer();
+    void ClearBuffers();
+
     std::unique_ptr<OHOS::AudioStandard::AudioCapturer> audioCapturer_ = nullptr;
     size_t bufferSize_ = 0; // minimum size of each buffer acquired from AudioServer
     uint64_t bufferDurationNs_ = 0; // each buffer
@@ -46,6 +64,25 @@ private:
     uint32_t pausedCount_ = 0; // the paused count times
     uint64_t persistTime_ = 0;
     uint64_t totalPauseTime_ = 0;
+    uint32_t sampleRate_ = 0;
+    uint32_t bytesPerFrame_ = 0;
+    bool needAnchor_ = true; // query the audio time again at the first buffer after start or resume
+    uint64_t anchorTime_ = 0;
+    uint64_t capturedFrames_ = 0; // frames captured since the anchor
+    uint64_t overrunCount_ = 0; // times the capture thread found the ring full
+    GstBufferPool *bufferPool_ = nullptr;
+    std::unique_ptr<std::thread> captureThread_;
+    std::atomic<bool> captureRunning_ { false };
+    // single producer (the capture thread) and single consumer (the streaming thread) ring.
+    std::array<GstBuffer *, RING_SIZE> ring_ {};
+    std::atomic<size_t> ringRead_ { 0 };
+    std::atomic<size_t> ringWrite_ { 0 };
+    std::mutex mutex_;
+    std::condition_variable cond_; // wakes the consumer on data, unlock or stop
+    std::condition_variable spaceCond_; // wakes the capture thread blocked on a full ring
+    bool started_ = false;
+    bool unlocked_ = false;
+    bool captureFailed_ = false;
 };
 }  // namespace Media
 }  // namespace OHOS
@@ -52,6 +52,7 @@ struct _GstAudioCaptureSrc {
     guint32 sample_rate;
     gboolean is_start;
     gboolean need_caps_info;
+    gboolean is_unlocked;
 };
 
 struct _GstAudioCaptureSrcClass {
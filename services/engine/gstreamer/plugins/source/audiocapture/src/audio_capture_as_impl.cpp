@@ -24,6 +24,8 @@ namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AudioCaptureAsImpl"};
     constexpr size_t MAXIMUM_BUFFER_SIZE = 100000;
     const uint64_t SECTONANOSECOND = 1000000000;
+    constexpr uint32_t BITS_PER_BYTE = 8;
+    constexpr guint POOL_MIN_BUFFERS = 4;
 }
 
 namespace OHOS {
@@ -34,6 +36,9 @@ AudioCaptureAsImpl::AudioCaptureAsImpl()
 
 AudioCaptureAsImpl::~AudioCaptureAsImpl()
 {
+    StopCaptureThread();
+    ClearBuffers();
+    DestroyBufferPool();
     if (audioCapturer_ != nullptr) {
         (void)audioCapturer_->Release();
         audioCapturer_ = nullptr;
@@ -86,6 +91,8 @@ int32_t AudioCaptureAsImpl::SetCaptureParameter(uint32_t bitrate, uint32_t chann
     CHECK_AND_RETURN_RET(audioCapturer_->GetBufferSize(bufferSize_) == AudioStandard::SUCCESS, MSERR_UNKNOWN);
     MEDIA_LOGD("audio buffer size is: %{public}zu", bufferSize_);
     CHECK_AND_RETURN_RET_LOG(bufferSize_ < MAXIMUM_BUFFER_SIZE, MSERR_UNKNOWN, "audio buffer size too long");
+    sampleRate_ = static_cast<uint32_t>(params.samplingRate);
+    bytesPerFrame_ = (AudioStandard::SAMPLE_S16LE / BITS_PER_BYTE) * static_cast<uint32_t>(params.audioChannel);
     return MSERR_OK;
 }
 
@@ -100,9 +107,8 @@ int32_t AudioCaptureAsImpl::GetCaptureParameter(uint32_t &bitrate, uint32_t &cha
     sampleRate = params.samplingRate;
     MEDIA_LOGD("get channels:%{public}u, sampleRate:%{public}u from audio server", channels, sampleRate);
     CHECK_AND_RETURN_RET(bufferSize_ > 0 && channels > 0 && sampleRate > 0, MSERR_UNKNOWN);
-    const uint32_t bitsPerByte = 8;
     bufferDurationNs_ = (bufferSize_ * SECTONANOSECOND) /
-        (sampleRate * (AudioStandard::SAMPLE_S16LE / bitsPerByte) * channels);
+        (sampleRate * (AudioStandard::SAMPLE_S16LE / BITS_PER_BYTE) * channels);
 
     MEDIA_LOGD("audio frame duration is (%{public}" PRIu64 ") ns", bufferDurationNs_);
     return MSERR_OK;
@@ -123,53 +129,250 @@ int32_t AudioCaptureAsImpl::GetSegmentInfo(uint64_t &start)
     return MSERR_OK;
 }
 
-std::shared_ptr<AudioBuffer> AudioCaptureAsImpl::GetBuffer()
+int32_t AudioCaptureAsImpl::CreateBufferPool()
 {
-    CHECK_AND_RETURN_RET(audioCapturer_ != nullptr, nullptr);
-    std::shared_ptr<AudioBuffer> buffer = std::make_shared<AudioBuffer>();
-    CHECK_AND_RETURN_RET(bufferSize_ > 0 && bufferSize_ < MAXIMUM_BUFFER_SIZE, nullptr);
-    buffer->gstBuffer = gst_buffer_new_allocate(nullptr, bufferSize_, nullptr);
-    CHECK_AND_RETURN_RET(buffer->gstBuffer != nullptr, nullptr);
+    if (bufferPool_ != nullptr) {
+        return MSERR_OK;
+    }
+    CHECK_AND_RETURN_RET(bufferSize_ > 0 && bufferSize_ < MAXIMUM_BUFFER_SIZE, MSERR_INVALID_OPERATION);
+    bufferPool_ = gst_buffer_pool_new();
+    CHECK_AND_RETURN_RET(bufferPool_ != nullptr, MSERR_NO_MEMORY);
 
-    GstMapInfo map = GST_MAP_INFO_INIT;
-    if (gst_buffer_map(buffer->gstBuffer, &map, GST_MAP_READ) != TRUE) {
-        gst_buffer_unref(buffer->gstBuffer);
-        return nullptr;
+    // no upper limit, the pool only grows when the downstream holds more buffers than it preallocates.
+    GstStructure *config = gst_buffer_pool_get_config(bufferPool_);
+    gst_buffer_pool_config_set_params(config, nullptr, static_cast<guint>(bufferSize_), POOL_MIN_BUFFERS, 0);
+    if (!gst_buffer_pool_set_config(bufferPool_, config) || !gst_buffer_pool_set_active(bufferPool_, TRUE)) {
+        MEDIA_LOGE("failed to activate the audio buffer pool");
+        gst_object_unref(bufferPool_);
+        bufferPool_ = nullptr;
+        return MSERR_NO_MEMORY;
     }
-    bool isBlocking = true;
-    int32_t bytesRead = audioCapturer_->Read(*(map.data), map.size, isBlocking);
-    gst_buffer_unmap(buffer->gstBuffer, &map);
-    if (bytesRead <= 0) {
-        gst_buffer_unref(buffer->gstBuffer);
-        return nullptr;
+    return MSERR_OK;
+}
+
+void AudioCaptureAsImpl::DestroyBufferPool()
+{
+    if (bufferPool_ == nullptr) {
+        return;
     }
+    (void)gst_buffer_pool_set_active(bufferPool_, FALSE);
+    gst_object_unref(bufferPool_);
+    bufferPool_ = nullptr;
+}
 
-    if (GetSegmentInfo(timestamp_) != MSERR_OK) {
-        gst_buffer_unref(buffer->gstBuffer);
-        return nullptr;
+int32_t AudioCaptureAsImpl::StartCaptureThread()
+{
+    CHECK_AND_RETURN_RET(captureThread_ == nullptr, MSERR_OK);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        captureFailed_ = false;
+    }
+    needAnchor_ = true;
+    captureRunning_ = true;
+    captureThread_ = std::make_unique<std::thread>(&AudioCaptureAsImpl::CaptureLoop, this);
+    CHECK_AND_RETURN_RET(captureThread_ != nullptr, MSERR_NO_MEMORY);
+    return MSERR_OK;
+}
+
+void AudioCaptureAsImpl::StopCaptureThread()
+{
+    // the capturer must have been stopped already, otherwise the loop may be blocked in the Read.
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        captureRunning_ = false;
+        spaceCond_.notify_all();
+    }
+    if (captureThread_ != nullptr && captureThread_->joinable()) {
+        captureThread_->join();
+    }
+    captureThread_ = nullptr;
+}
+
+void AudioCaptureAsImpl::CaptureLoop()
+{
+    MEDIA_LOGD("capture loop in");
+    while (captureRunning_) {
+        GstBuffer *buffer = nullptr;
+        if (gst_buffer_pool_acquire_buffer(bufferPool_, &buffer, nullptr) != GST_FLOW_OK || buffer == nullptr) {
+            MEDIA_LOGE("failed to acquire buffer from the pool");
+            break;
+        }
+
+        GstMapInfo map = GST_MAP_INFO_INIT;
+        if (gst_buffer_map(buffer, &map, GST_MAP_WRITE) != TRUE) {
+            gst_buffer_unref(buffer);
+            break;
+        }
+        bool isBlocking = true;
+        int32_t bytesRead = audioCapturer_->Read(*(map.data), map.size, isBlocking);
+        gst_buffer_unmap(buffer, &map);
+        if (bytesRead <= 0 && !captureRunning_) {
+            gst_buffer_unref(buffer); // the capturer is paused or stopped while reading
+            break;
+        }
+        if (bytesRead <= 0 || !StampBuffer(buffer, static_cast<size_t>(bytesRead))) {
+            MEDIA_LOGE("failed to read audio data, ret: %{public}d", bytesRead);
+            gst_buffer_unref(buffer);
+            break;
+        }
+
+        if (!PushBuffer(buffer)) {
+            gst_buffer_unref(buffer); // flushing or stopping, the buffer would be discarded downstream anyway
+        }
     }
 
+    if (captureRunning_) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        captureFailed_ = true;
+        cond_.notify_all();
+    }
+    MEDIA_LOGD("capture loop out");
+}
+
+bool AudioCaptureAsImpl::StampBuffer(GstBuffer *buffer, size_t size)
+{
+    CHECK_AND_RETURN_RET(sampleRate_ > 0 && bytesPerFrame_ > 0, false);
+    // only the first buffer after start or resume queries the audio time, the following ones are counted
+    // from it by the number of frames captured, so the timestamps are continuous and cost nothing to get.
+    if (needAnchor_) {
+        CHECK_AND_RETURN_RET(GetSegmentInfo(anchorTime_) == MSERR_OK, false);
+        capturedFrames_ = 0;
+        needAnchor_ = false;
+    }
+
+    uint64_t frames = size / bytesPerFrame_;
+    gst_buffer_set_size(buffer, static_cast<gssize>(size));
+    GST_BUFFER_PTS(buffer) = anchorTime_ + gst_util_uint64_scale(capturedFrames_, SECTONANOSECOND, sampleRate_);
+    GST_BUFFER_DURATION(buffer) = gst_util_uint64_scale(frames, SECTONANOSECOND, sampleRate_);
+    capturedFrames_ += frames;
+    return true;
+}
+
+bool AudioCaptureAsImpl::PushBuffer(GstBuffer *buffer)
+{
+    size_t write = ringWrite_.load(std::memory_order_relaxed);
+    if (write - ringRead_.load(std::memory_order_acquire) >= RING_SIZE) {
+        // the consumer is behind, hold the capture thread instead of dropping pcm. Audio keeps buffering
+        // in the capturer meanwhile, so a short stall of the streaming thread loses nothing.
+        if (overrunCount_++ == 0) {
+            MEDIA_LOGW("audio capture ring is full, wait for the consumer");
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        spaceCond_.wait(lock, [this, write] {
+            return write - ringRead_.load(std::memory_order_acquire) < RING_SIZE ||
+                !captureRunning_ || unlocked_ || !started_;
+        });
+        if (write - ringRead_.load(std::memory_order_acquire) >= RING_SIZE) {
+            return false;
+        }
+    }
+    ring_[write % RING_SIZE] = buffer;
+    ringWrite_.store(write + 1, std::memory_order_release);
+
+    // the lock only orders the notification after the predicate check of a waiting consumer.
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+    }
+    cond_.notify_one();
+    return true;
+}
+
+GstBuffer *AudioCaptureAsImpl::PopBuffer()
+{
+    size_t read = ringRead_.load(std::memory_order_relaxed);
+    if (ringWrite_.load(std::memory_order_acquire) == read) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this, read] {
+            return ringWrite_.load(std::memory_order_acquire) != read || unlocked_ || captureFailed_ || !started_;
+        });
+        if (ringWrite_.load(std::memory_order_acquire) == read) {
+            return nullptr;
+        }
+    }
+
+    GstBuffer *buffer = ring_[read % RING_SIZE];
+    ring_[read % RING_SIZE] = nullptr;
+    ringRead_.store(read + 1, std::memory_order_release);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+    }
+    spaceCond_.notify_one();
+    return buffer;
+}
+
+void AudioCaptureAsImpl::ClearBuffers()
+{
+    size_t read = ringRead_.load(std::memory_order_relaxed);
+    size_t write = ringWrite_.load(std::memory_order_acquire);
+    for (; read != write; ++read) {
+        gst_buffer_unref(ring_[read % RING_SIZE]);
+        ring_[read % RING_SIZE] = nullptr;
+    }
+    ringRead_.store(read, std::memory_order_release);
+}
+
+std::shared_ptr<AudioBuffer> AudioCaptureAsImpl::GetBuffer()
+{
+    GstBuffer *gstBuffer = PopBuffer();
+    CHECK_AND_RETURN_RET(gstBuffer != nullptr, nullptr);
+
+    std::shared_ptr<AudioBuffer> buffer = std::make_shared<AudioBuffer>();
+    if (buffer == nullptr) {
+        gst_buffer_unref(gstBuffer);
+        return nullptr;
+    }
+    timestamp_ = GST_BUFFER_PTS(gstBuffer);
+    buffer->gstBuffer = gstBuffer;
     buffer->timestamp = timestamp_ - totalPauseTime_;
-    buffer->duration = bufferDurationNs_;
-    buffer->dataLen = bufferSize_;
+    buffer->duration = GST_BUFFER_DURATION(gstBuffer);
+    buffer->dataLen = gst_buffer_get_size(gstBuffer);
     return buffer;
 }
 
+void AudioCaptureAsImpl::UnLock(bool start)
+{
+    MEDIA_LOGD("UnLock: %{public}d", start);
+    std::unique_lock<std::mutex> lock(mutex_);
+    unlocked_ = start;
+    cond_.notify_all();
+    spaceCond_.notify_all();
+}
+
 int32_t AudioCaptureAsImpl::StartAudioCapture()
 {
     MEDIA_LOGD("StartAudioCapture");
     CHECK_AND_RETURN_RET(audioCapturer_ != nullptr, MSERR_INVALID_OPERATION);
+    CHECK_AND_RETURN_RET(CreateBufferPool() == MSERR_OK, MSERR_NO_MEMORY);
     CHECK_AND_RETURN_RET(audioCapturer_->Start(), MSERR_UNKNOWN);
-    return MSERR_OK;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        started_ = true;
+    }
+    return StartCaptureThread();
 }
 
 int32_t AudioCaptureAsImpl::StopAudioCapture()
 {
     MEDIA_LOGD("StopAudioCapture");
     CHECK_AND_RETURN_RET(audioCapturer_ != nullptr, MSERR_INVALID_OPERATION);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        started_ = false;
+        cond_.notify_all();
+        spaceCond_.notify_all();
+    }
+    captureRunning_ = false;
     if (audioCapturer_->GetStatus() == AudioStandard::CapturerState::CAPTURER_RUNNING) {
         CHECK_AND_RETURN_RET(audioCapturer_->Stop(), MSERR_UNKNOWN);
     }
+    StopCaptureThread();
+    ClearBuffers();
+    DestroyBufferPool();
+    if (overrunCount_ > 0) {
+        MEDIA_LOGW("audio capture waited %{public}" PRIu64 " times for a full ring", overrunCount_);
+        overrunCount_ = 0;
+    }
     if (audioCapturer_->GetStatus() != AudioStandard::CapturerState::CAPTURER_RELEASED) {
         CHECK_AND_RETURN_RET(audioCapturer_->Release(), MSERR_UNKNOWN);
     }
@@ -188,9 +391,11 @@ int32_t AudioCaptureAsImpl::PauseAudioCapture()
     pausedTime_ = timestamp_;
 
     CHECK_AND_RETURN_RET(audioCapturer_ != nullptr, MSERR_INVALID_OPERATION);
+    captureRunning_ = false;
     if (audioCapturer_->GetStatus() == AudioStandard::CapturerState::CAPTURER_RUNNING) {
         CHECK_AND_RETURN_RET(audioCapturer_->Stop(), MSERR_UNKNOWN);
     }
+    StopCaptureThread();
     pausedCount_++; // add one pause time count
     MEDIA_LOGD("exit PauseAudioCapture");
     return MSERR_OK;
@@ -210,6 +415,7 @@ int32_t AudioCaptureAsImpl::ResumeAudioCapture()
     totalPauseTime_ += persistTime_;
     CHECK_AND_RETURN_RET(audioCapturer_ != nullptr, MSERR_INVALID_OPERATION);
     CHECK_AND_RETURN_RET(audioCapturer_->Start(), MSERR_UNKNOWN);
+    CHECK_AND_RETURN_RET(StartCaptureThread() == MSERR_OK, MSERR_UNKNOWN);
 
     MEDIA_LOGI("audio capture has %{public}d times paused, persistTime: %{public}" PRIu64 ",totalPauseTime: %{public}"
         PRIu64 "", pausedCount_, persistTime_, totalPauseTime_);
@@ -51,6 +51,8 @@ static void gst_audio_capture_src_get_property(GObject *object, guint prop_id,
 static GstFlowReturn gst_audio_capture_src_create(GstPushSrc *psrc, GstBuffer **outbuf);
 static GstStateChangeReturn gst_audio_capture_src_change_state(GstElement *element, GstStateChange transition);
 static gboolean gst_audio_capture_src_negotiate(GstBaseSrc *basesrc);
+static gboolean gst_audio_capture_src_unlock(GstBaseSrc *basesrc);
+static gboolean gst_audio_capture_src_unlock_stop(GstBaseSrc *basesrc);
 
 #define GST_TYPE_AUDIO_CAPTURE_SRC_SOURCE_TYPE (gst_audio_capture_src_source_type_get_type())
 static GType gst_audio_capture_src_source_type_get_type(void)
@@ -107,6 +109,8 @@ static void gst_audio_capture_src_class_init(GstAudioCaptureSrcClass *klass)
 
     gstelement_class->change_state = gst_audio_capture_src_change_state;
     gstbasesrc_class->negotiate = gst_audio_capture_src_negotiate;
+    gstbasesrc_class->unlock = gst_audio_capture_src_unlock;
+    gstbasesrc_class->unlock_stop = gst_audio_capture_src_unlock_stop;
     gstpushsrc_class->create = gst_audio_capture_src_create;
 }
 
@@ -124,6 +128,7 @@ static void gst_audio_capture_src_init(GstAudioCaptureSrc *src)
     src->sample_rate = 0;
     src->is_start = FALSE;
     src->need_caps_info = TRUE;
+    src->is_unlocked = FALSE;
     gst_base_src_set_blocksize(GST_BASE_SRC(src), 0);
 }
 
@@ -309,6 +314,9 @@ static GstFlowReturn gst_audio_capture_src_create(GstPushSrc *psrc, GstBuffer **
     g_return_val_if_fail(src->audio_capture != nullptr, GST_FLOW_ERROR);
 
     std::shared_ptr<AudioBuffer> audio_buffer = src->audio_capture->GetBuffer();
+    if (audio_buffer == nullptr && src->is_unlocked) {
+        return GST_FLOW_FLUSHING; // the base class restarts the streaming when playing again
+    }
     g_return_val_if_fail(audio_buffer != nullptr, GST_FLOW_ERROR);
     gst_base_src_set_blocksize(GST_BASE_SRC_CAST(src), audio_buffer->dataLen);
 
@@ -328,6 +336,30 @@ static gboolean gst_audio_capture_src_negotiate(GstBaseSrc *basesrc)
     return gst_base_src_set_caps(basesrc, src->src_caps);
 }
 
+static gboolean gst_audio_capture_src_unlock(GstBaseSrc *basesrc)
+{
+    g_return_val_if_fail(basesrc != nullptr, FALSE);
+    GstAudioCaptureSrc *src = GST_AUDIO_CAPTURE_SRC(basesrc);
+    g_return_val_if_fail(src != nullptr, FALSE);
+    src->is_unlocked = TRUE;
+    if (src->audio_capture != nullptr) {
+        src->audio_capture->UnLock(true);
+    }
+    return TRUE;
+}
+
+static gboolean gst_audio_capture_src_unlock_stop(GstBaseSrc *basesrc)
+{
+    g_return_val_if_fail(basesrc != nullptr, FALSE);
+    GstAudioCaptureSrc *src = GST_AUDIO_CAPTURE_SRC(basesrc);
+    g_return_val_if_fail(src != nullptr, FALSE);
+    src->is_unlocked = FALSE;
+    if (src->audio_capture != nullptr) {
+        src->audio_capture->UnLock(false);
+    }
+    return TRUE;
+}
+
 static gboolean plugin_init(GstPlugin *plugin)
 {
     g_return_val_if_fail(plugin != nullptr, false);
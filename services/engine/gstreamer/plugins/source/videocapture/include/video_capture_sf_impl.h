@@ -58,6 +58,9 @@ protected:
     };
     void OnBufferAvailable();
     int32_t GetSufferExtraData();
+    GstBuffer *WrapSurfaceBuffer(uint32_t offset, uint32_t size);
+    GstBuffer *CopySurfaceBuffer(const uint8_t *data, uint32_t size);
+    static void WrappedSurfaceBufferDestroyNotify(gpointer userData);
 
     uint32_t videoWidth_;
     uint32_t videoHeight_;
@@ -77,6 +80,8 @@ protected:
     int32_t dataSize_ = 0;
     int64_t pts_ = 0;
     int32_t isCodecFrame_ = 0;
+    // the surface buffers wrapped and still held downstream, shared with the wrappers outliving the capture
+    std::shared_ptr<std::atomic<int32_t>> wrappedBuffersNum_;
 
 private:
     void SetSurfaceUserData();
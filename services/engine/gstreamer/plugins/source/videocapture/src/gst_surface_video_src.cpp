@@ -15,6 +15,7 @@
 
 #include "config.h"
 #include "gst_surface_video_src.h"
+#include <string>
 #include <gst/gst.h>
 #include "media_errors.h"
 #include "video_capture_factory.h"
@@ -28,6 +29,9 @@ GST_STATIC_PAD_TEMPLATE("src",
 namespace {
     constexpr VideoStreamType DEFAULT_STREAM_TYPE = VIDEO_STREAM_TYPE_UNKNOWN;
     constexpr gint DEFAULT_FRAME_RATE = 30;
+    // used if the sps of the stream can not be parsed
+    constexpr const gchar *DEFAULT_PROFILE = "high";
+    constexpr const gchar *DEFAULT_LEVEL = "2";
 }
 
 enum {
@@ -209,6 +213,48 @@ static void gst_surface_video_src_get_property(GObject *object, guint prop_id, G
     }
 }
 
+static const gchar *get_avc_profile(const EsAvcCodecBuffer &codec_buffer)
+{
+    constexpr uint32_t constraint_set1_flag = 0x40;
+    switch (codec_buffer.profileIdc) {
+        case 0:
+            return DEFAULT_PROFILE;
+        case 66: // baseline
+            return (codec_buffer.constraintFlags & constraint_set1_flag) ? "constrained-baseline" : "baseline";
+        case 77: // main
+            return "main";
+        case 88: // extended
+            return "extended";
+        case 100: // high
+            return "high";
+        case 110: // high 10
+            return "high-10";
+        case 122: // high 4:2:2
+            return "high-4:2:2";
+        case 244: // high 4:4:4 predictive
+            return "high-4:4:4";
+        default:
+            return nullptr;
+    }
+}
+
+static std::string get_avc_level(const EsAvcCodecBuffer &codec_buffer)
+{
+    constexpr uint32_t level_1b = 9;
+    constexpr uint32_t level_scale = 10;
+    if (codec_buffer.levelIdc == 0) {
+        return DEFAULT_LEVEL;
+    }
+    if (codec_buffer.levelIdc == level_1b) {
+        return "1b";
+    }
+    std::string level = std::to_string(codec_buffer.levelIdc / level_scale);
+    if (codec_buffer.levelIdc % level_scale != 0) {
+        level += "." + std::to_string(codec_buffer.levelIdc % level_scale);
+    }
+    return level;
+}
+
 static gboolean process_codec_data(GstSurfaceVideoSrc *src)
 {
     g_return_val_if_fail(src != nullptr, FALSE);
@@ -225,15 +271,28 @@ static gboolean process_codec_data(GstSurfaceVideoSrc *src)
         gst_caps_unref(src->src_caps);
     }
 
+    // the caps follow the sps of the stream, so that downstream is configured once at the start.
+    gint fps_n = DEFAULT_FRAME_RATE;
+    gint fps_d = 1;
+    if (codec_buffer->frameRateNum > 0 && codec_buffer->frameRateNum <= G_MAXINT &&
+        codec_buffer->frameRateDen > 0 && codec_buffer->frameRateDen <= G_MAXINT) {
+        fps_n = static_cast<gint>(codec_buffer->frameRateNum);
+        fps_d = static_cast<gint>(codec_buffer->frameRateDen);
+    }
+    src->video_width = codec_buffer->width;
+    src->video_height = codec_buffer->height;
     src->src_caps = gst_caps_new_simple("video/x-h264",
         "width", G_TYPE_INT, codec_buffer->width,
         "height", G_TYPE_INT, codec_buffer->height,
-        "framerate", GST_TYPE_FRACTION, DEFAULT_FRAME_RATE, 1,
+        "framerate", GST_TYPE_FRACTION, fps_n, fps_d,
         "pixel-aspect-ratio", GST_TYPE_FRACTION, 1, 1,
-        "level", G_TYPE_STRING, "2",
-        "profile", G_TYPE_STRING, "high",
+        "level", G_TYPE_STRING, get_avc_level(*codec_buffer).c_str(),
         "alignment", G_TYPE_STRING, "au",
         "stream-format", G_TYPE_STRING, "avc", nullptr);
+    const gchar *profile = get_avc_profile(*codec_buffer);
+    if (profile != nullptr) {
+        gst_caps_set_simple(src->src_caps, "profile", G_TYPE_STRING, profile, nullptr);
+    }
     gst_caps_set_simple(src->src_caps, "codec_data", GST_TYPE_BUFFER, codec_buffer->gstCodecBuffer, nullptr);
     GstBaseSrc *basesrc = GST_BASE_SRC_CAST(src);
     basesrc->segment.start = codec_buffer->segmentStart;
@@ -262,6 +321,20 @@ static gboolean set_fix_caps(GstSurfaceVideoSrc *src)
     return TRUE;
 }
 
+static gboolean update_frame_size(GstSurfaceVideoSrc *src, const VideoFrameBuffer &frame_buffer)
+{
+    if (frame_buffer.width == 0 || frame_buffer.height == 0 ||
+        (frame_buffer.width == src->video_width && frame_buffer.height == src->video_height)) {
+        return TRUE;
+    }
+    GST_INFO_OBJECT(src, "frame size %ux%u differs from %ux%u, update caps", frame_buffer.width,
+        frame_buffer.height, src->video_width, src->video_height);
+    src->video_width = frame_buffer.width;
+    src->video_height = frame_buffer.height;
+    g_return_val_if_fail(set_fix_caps(src) == TRUE, FALSE);
+    return gst_base_src_set_caps(GST_BASE_SRC_CAST(src), src->src_caps);
+}
+
 static gboolean start_video_capture(GstSurfaceVideoSrc *src)
 {
     g_return_val_if_fail(src != nullptr, FALSE);
@@ -381,6 +454,10 @@ static GstFlowReturn gst_surface_video_src_create(GstPushSrc *psrc, GstBuffer **
         return GST_FLOW_EOS;
     }
     g_return_val_if_fail(frame_buffer != nullptr, GST_FLOW_ERROR);
+    if (!src->need_codec_data && update_frame_size(src, *frame_buffer) != TRUE) {
+        gst_buffer_unref(frame_buffer->gstBuffer);
+        return GST_FLOW_NOT_NEGOTIATED;
+    }
 
     gst_base_src_set_blocksize(GST_BASE_SRC_CAST(src), static_cast<guint>(frame_buffer->size));
 
@@ -16,6 +16,8 @@
 #include "video_capture_sf_es_avc_impl.h"
 #include "media_log.h"
 #include "media_errors.h"
+#include "h264_sps_parser.h"
+#include "nal_scanner.h"
 #include "scope_guard.h"
 #include "securec.h"
 
@@ -105,6 +107,21 @@ std::shared_ptr<EsAvcCodecBuffer> VideoCaptureSfEsAvcImpl::DoGetCodecBuffer()
     CHECK_AND_RETURN_RET_LOG(codecBuffer != nullptr, nullptr, "no memory");
     codecBuffer->width = videoWidth_;
     codecBuffer->height = videoHeight_;
+    H264SpsInfo spsInfo;
+    if (H264SpsParser::Parse(sps.data(), sps.size(), spsInfo)) {
+        MEDIA_LOGI("sps: profile %{public}u, level %{public}u, %{public}ux%{public}u, framerate %{public}u/%{public}u",
+            spsInfo.profileIdc, spsInfo.levelIdc, spsInfo.width, spsInfo.height, spsInfo.frameRateNum,
+            spsInfo.frameRateDen);
+        codecBuffer->width = spsInfo.width;
+        codecBuffer->height = spsInfo.height;
+        codecBuffer->profileIdc = spsInfo.profileIdc;
+        codecBuffer->constraintFlags = spsInfo.constraintFlags;
+        codecBuffer->levelIdc = spsInfo.levelIdc;
+        codecBuffer->frameRateNum = spsInfo.frameRateNum;
+        codecBuffer->frameRateDen = spsInfo.frameRateDen;
+    } else {
+        MEDIA_LOGW("parse sps failed, use the configured size %{public}ux%{public}u", videoWidth_, videoHeight_);
+    }
     codecBuffer->segmentStart = 0;
     codecBuffer->gstCodecBuffer = configBuffer;
     codecData_ = (char *)buffer;
@@ -132,8 +149,13 @@ std::shared_ptr<VideoFrameBuffer> VideoCaptureSfEsAvcImpl::DoGetFrameBuffer()
     gpointer buffer = surfaceBuffer_->GetVirAddr();
     CHECK_AND_RETURN_RET_LOG(buffer != nullptr, nullptr, "surface buffer address is invalid");
 
+    // the key frames carry the sps, pps and sei ahead, which are sent as the codec data already.
+    uint32_t offset = 0;
     if (isCodecFrame_ == 1) {
-        buffer = (char *)buffer + codecDataSize_;
+        CHECK_AND_RETURN_RET_LOG(bufferSize > codecDataSize_, nullptr, "illegal key frame size");
+        offset = codecDataSize_;
+        buffer = (char *)buffer + offset;
+        bufferSize -= offset;
     }
 
     uint32_t frameSize = bufferSize - nalSize_;
@@ -151,14 +173,12 @@ std::shared_ptr<VideoFrameBuffer> VideoCaptureSfEsAvcImpl::DoGetFrameBuffer()
         ((char *)buffer)[2] = (char)(frameSize & 0xff);
     }
 
-    GstBuffer *gstBuffer = gst_buffer_new_allocate(nullptr, bufferSize, nullptr);
-    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "no memory");
+    GstBuffer *gstBuffer = WrapSurfaceBuffer(offset, bufferSize);
+    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "wrap surface buffer failed");
+    CANCEL_SCOPE_EXIT_GUARD(0); // released when the gstBuffer is freed, or already if copied out
 
     ON_SCOPE_EXIT(1) { gst_buffer_unref(gstBuffer); };
 
-    gsize size = gst_buffer_fill(gstBuffer, 0, (char *)buffer, bufferSize);
-    CHECK_AND_RETURN_RET_LOG(size == static_cast<gsize>(bufferSize), nullptr, "unkonwn error during gst_buffer_fill");
-
     std::shared_ptr<VideoFrameBuffer> frameBuffer = std::make_shared<VideoFrameBuffer>();
     frameBuffer->keyFrameFlag = 0;
     frameBuffer->timeStamp = static_cast<uint64_t>(pts_);
@@ -175,11 +195,8 @@ std::shared_ptr<VideoFrameBuffer> VideoCaptureSfEsAvcImpl::GetIDRFrame()
         (void)dataConSurface_->ReleaseBuffer(surfaceBuffer_, fence_);
     };
 
+    CHECK_AND_RETURN_RET_LOG(codecData_ != nullptr, nullptr, "codec data is nullptr");
     uint32_t bufferSize = static_cast<uint32_t>(dataSize_) - codecDataSize_;
-    GstBuffer *gstBuffer = gst_buffer_new_allocate(nullptr, bufferSize, nullptr);
-    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "no memory");
-
-    ON_SCOPE_EXIT(1) { gst_buffer_unref(gstBuffer); };
 
     // there is two kind of nal head. four byte 0x00000001 or three byte 0x000001
     // standard es_avc stream should begin with frame size
@@ -196,8 +213,11 @@ std::shared_ptr<VideoFrameBuffer> VideoCaptureSfEsAvcImpl::GetIDRFrame()
         codecData_[codecDataSize_ + 2] = (char)(frameSize & 0xff);
     }
 
-    gsize size = gst_buffer_fill(gstBuffer, 0, codecData_ + codecDataSize_, bufferSize);
-    CHECK_AND_RETURN_RET_LOG(size == static_cast<gsize>(bufferSize), nullptr, "unkonwn error during gst_buffer_fill");
+    GstBuffer *gstBuffer = WrapSurfaceBuffer(codecDataSize_, bufferSize);
+    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "wrap surface buffer failed");
+    CANCEL_SCOPE_EXIT_GUARD(0); // released when the gstBuffer is freed, or already if copied out
+
+    ON_SCOPE_EXIT(1) { gst_buffer_unref(gstBuffer); };
 
     std::shared_ptr<VideoFrameBuffer> frameBuffer = std::make_shared<VideoFrameBuffer>();
     frameBuffer->keyFrameFlag = 0;
@@ -215,18 +235,7 @@ const uint8_t *VideoCaptureSfEsAvcImpl::FindNextNal(const uint8_t *start, const
 {
     CHECK_AND_RETURN_RET(start != nullptr && end != nullptr, nullptr);
     // there is two kind of nal head. four byte 0x00000001 or three byte 0x000001
-    while (start <= end - 3) {
-        if (start[0] == 0x00 && start[1] == 0x00 && start[2] == 0x01) {
-            nalSize_ = 3; // 0x000001 Nal
-            return start;
-        }
-        if (start[0] == 0x00 && start[1] == 0x00 && start[2] == 0x00 && start[3] == 0x01) {
-            nalSize_ = 4; // 0x00000001 Nal
-            return start;
-        }
-        start++;
-    }
-    return end;
+    return NalScanner::FindStartCode(start, end, nalSize_);
 }
 
 void VideoCaptureSfEsAvcImpl::GetCodecData(const uint8_t *data, int32_t len,
@@ -243,13 +252,14 @@ void VideoCaptureSfEsAvcImpl::GetCodecData(const uint8_t *data, int32_t len,
         }
         pBegin += nalSize_;
         pEnd = FindNextNal(pBegin, end);
-        if (((*pBegin) & 0x1F) == 0x07) { // sps
+        uint32_t nalType = NalScanner::GetNalType(pBegin, NAL_CODEC_H264);
+        if (nalType == 0x07) { // sps
             sps.assign(pBegin, pBegin + static_cast<int>(pEnd - pBegin));
         }
-        if (((*pBegin) & 0x1F) == 0x08) { // pps
+        if (nalType == 0x08) { // pps
             pps.assign(pBegin, pBegin + static_cast<int>(pEnd - pBegin));
         }
-        if (((*pBegin) & 0x1F) == 0x06) { // sei
+        if (nalType == 0x06) { // sei
             sei.assign(pBegin, pBegin + static_cast<int>(pEnd - pBegin));
         }
         pBegin = pEnd;
@@ -23,6 +23,8 @@
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "VideoCaptureSfmpl"};
     constexpr int32_t DEFAULT_SURFACE_QUEUE_SIZE = 6;
+    // leave some surface buffers to the producer, the frames beyond are copied out instead of wrapped
+    constexpr int32_t MAX_WRAPPED_BUFFERS = DEFAULT_SURFACE_QUEUE_SIZE - 2;
     constexpr int32_t DEFAULT_SURFACE_SIZE = 1024 * 1024;
     constexpr int32_t DEFAULT_VIDEO_WIDTH = 1920;
     constexpr int32_t DEFAULT_VIDEO_HEIGHT = 1080;
@@ -30,6 +32,13 @@ namespace {
 
 namespace OHOS {
 namespace Media {
+struct WrappedSurfaceBuffer {
+    sptr<Surface> surface;
+    sptr<SurfaceBuffer> buffer;
+    int32_t fence;
+    std::shared_ptr<std::atomic<int32_t>> wrappedNum;
+};
+
 VideoCaptureSfImpl::VideoCaptureSfImpl()
     : videoWidth_(DEFAULT_VIDEO_WIDTH),
       videoHeight_(DEFAULT_VIDEO_HEIGHT),
@@ -43,7 +52,8 @@ VideoCaptureSfImpl::VideoCaptureSfImpl()
       streamType_(VIDEO_STREAM_TYPE_UNKNOWN),
       streamTypeUnknown_(true),
       dataConSurface_(nullptr),
-      producerSurface_(nullptr)
+      producerSurface_(nullptr),
+      wrappedBuffersNum_(std::make_shared<std::atomic<int32_t>>(0))
 {
 }
 
@@ -273,6 +283,72 @@ int32_t VideoCaptureSfImpl::AcquireSurfaceBuffer()
     return MSERR_OK;
 }
 
+GstBuffer *VideoCaptureSfImpl::WrapSurfaceBuffer(uint32_t offset, uint32_t size)
+{
+    CHECK_AND_RETURN_RET_LOG(surfaceBuffer_ != nullptr && dataConSurface_ != nullptr, nullptr, "surfacebuffer is null");
+    gpointer addr = surfaceBuffer_->GetVirAddr();
+    CHECK_AND_RETURN_RET_LOG(addr != nullptr, nullptr, "surface buffer address is invalid");
+    gsize maxSize = static_cast<gsize>(surfaceBuffer_->GetSize());
+    CHECK_AND_RETURN_RET_LOG(static_cast<gsize>(offset) + size <= maxSize, nullptr,
+        "data exceeds the surface buffer, offset: %{public}u, size: %{public}u", offset, size);
+
+    if (wrappedBuffersNum_->load() >= MAX_WRAPPED_BUFFERS) {
+        return CopySurfaceBuffer(static_cast<const uint8_t *>(addr) + offset, size);
+    }
+
+    GstBuffer *gstBuffer = gst_buffer_new();
+    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "no memory");
+
+    WrappedSurfaceBuffer *wrapped = new(std::nothrow) WrappedSurfaceBuffer {
+        dataConSurface_, surfaceBuffer_, fence_, wrappedBuffersNum_ };
+    if (wrapped == nullptr) {
+        gst_buffer_unref(gstBuffer);
+        MEDIA_LOGE("new wrapped surface buffer failed");
+        return nullptr;
+    }
+
+    // the surface buffer goes back to the consumer surface when the last reference downstream is dropped,
+    // readonly so that the elements wanting to write make their own copy.
+    GstMemory *memory = gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY, addr, maxSize,
+        static_cast<gsize>(offset), static_cast<gsize>(size), wrapped, WrappedSurfaceBufferDestroyNotify);
+    if (memory == nullptr) {
+        delete wrapped;
+        gst_buffer_unref(gstBuffer);
+        MEDIA_LOGE("wrap surface buffer failed");
+        return nullptr;
+    }
+    gst_buffer_append_memory(gstBuffer, memory);
+    (*wrappedBuffersNum_)++;
+    return gstBuffer;
+}
+
+GstBuffer *VideoCaptureSfImpl::CopySurfaceBuffer(const uint8_t *data, uint32_t size)
+{
+    GstBuffer *gstBuffer = gst_buffer_new_allocate(nullptr, static_cast<gsize>(size), nullptr);
+    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "no memory");
+
+    gsize copied = gst_buffer_fill(gstBuffer, 0, data, static_cast<gsize>(size));
+    if (copied != static_cast<gsize>(size)) {
+        gst_buffer_unref(gstBuffer);
+        MEDIA_LOGE("copy surface buffer failed");
+        return nullptr;
+    }
+
+    // the data is copied out, give the surface buffer back to the producer at once.
+    (void)dataConSurface_->ReleaseBuffer(surfaceBuffer_, fence_);
+    return gstBuffer;
+}
+
+void VideoCaptureSfImpl::WrappedSurfaceBufferDestroyNotify(gpointer userData)
+{
+    WrappedSurfaceBuffer *wrapped = static_cast<WrappedSurfaceBuffer *>(userData);
+    CHECK_AND_RETURN_LOG(wrapped != nullptr, "wrapped surface buffer is nullptr");
+    // the capture may be stopped already, the surface is kept alive by the wrapper.
+    (void)wrapped->surface->ReleaseBuffer(wrapped->buffer, wrapped->fence);
+    (*wrapped->wrappedNum)--;
+    delete wrapped;
+}
+
 void VideoCaptureSfImpl::ConsumerListenerProxy::OnBufferAvailable()
 {
     return owner_.OnBufferAvailable();
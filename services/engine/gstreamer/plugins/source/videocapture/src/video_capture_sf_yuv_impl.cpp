@@ -47,22 +47,21 @@ std::shared_ptr<VideoFrameBuffer> VideoCaptureSfYuvImpl::DoGetFrameBuffer()
 
     ON_SCOPE_EXIT(0) { (void)dataConSurface_->ReleaseBuffer(surfaceBuffer_, fence_); };
 
-    gpointer buffer = surfaceBuffer_->GetVirAddr();
-    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, nullptr, "surface buffer address is invalid");
-
-    GstBuffer *gstBuffer = gst_buffer_new_allocate(nullptr, bufferSize, nullptr);
-    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "no memory");
+    GstBuffer *gstBuffer = WrapSurfaceBuffer(0, bufferSize);
+    CHECK_AND_RETURN_RET_LOG(gstBuffer != nullptr, nullptr, "wrap surface buffer failed");
+    CANCEL_SCOPE_EXIT_GUARD(0); // released when the gstBuffer is freed, or already if copied out
 
     ON_SCOPE_EXIT(1) { gst_buffer_unref(gstBuffer); };
 
-    gsize size = gst_buffer_fill(gstBuffer, 0, (char *)buffer, bufferSize);
-    CHECK_AND_RETURN_RET_LOG(size == static_cast<gsize>(bufferSize), nullptr, "unkonwn error during gst_buffer_fill");
-
     std::shared_ptr<VideoFrameBuffer> frameBuffer = std::make_shared<VideoFrameBuffer>();
     frameBuffer->keyFrameFlag = 0;
     frameBuffer->timeStamp = static_cast<uint64_t>(pts_); // yuv timestamp from camera
     frameBuffer->gstBuffer = gstBuffer;
     frameBuffer->size = static_cast<uint64_t>(bufferSize);
+    if (surfaceBuffer_->GetWidth() > 0 && surfaceBuffer_->GetHeight() > 0) {
+        frameBuffer->width = static_cast<uint32_t>(surfaceBuffer_->GetWidth());
+        frameBuffer->height = static_cast<uint32_t>(surfaceBuffer_->GetHeight());
+    }
 
     CANCEL_SCOPE_EXIT_GUARD(1);
     return frameBuffer;
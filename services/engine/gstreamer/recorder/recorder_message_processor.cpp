@@ -17,7 +17,6 @@
 #include "recorder_inner_defines.h"
 #include "media_errors.h"
 #include "media_log.h"
-#include "scope_guard.h"
 #include "i_recorder_engine.h"
 
 namespace {
@@ -127,7 +126,7 @@ gboolean RecorderMsgProcessor::BusCallback(GstBus *bus, GstMessage *msg, gpointe
 }
 
 RecorderMsgProcessor::RecorderMsgProcessor(GstBus &gstBus, const MessageResCb &resCb)
-    : mainLoopGuard_("rec-pipe-guard"), msgResultCb_(resCb)
+    : msgResultCb_(resCb)
 {
     gstBus_ = GST_BUS_CAST(gst_object_ref(&gstBus));
 }
@@ -149,23 +148,9 @@ int32_t RecorderMsgProcessor::Init()
         return MSERR_INVALID_VAL;
     }
 
-    ON_SCOPE_EXIT(0) { (void)Reset(); };
+    busWatch_ = GstBusDispatcher::Inst().Attach(*gstBus_, &RecorderMsgProcessor::BusCallback, this);
+    CHECK_AND_RETURN_RET(busWatch_ != nullptr, MSERR_INVALID_OPERATION);
 
-    mainLoop_ = g_main_loop_new(nullptr, FALSE);
-    CHECK_AND_RETURN_RET(mainLoop_ != nullptr, MSERR_NO_MEMORY);
-
-    busWatchId_ = gst_bus_add_watch(gstBus_, (GstBusFunc)&RecorderMsgProcessor::BusCallback, this);
-    CHECK_AND_RETURN_RET(busWatchId_ != 0, MSERR_INVALID_OPERATION);
-
-    int32_t ret = mainLoopGuard_.Start();
-    CHECK_AND_RETURN_RET(ret == MSERR_OK, MSERR_INVALID_OPERATION);
-
-    auto mainLoopGuardTask = std::make_shared<TaskHandler<void>>([this] { g_main_loop_run(mainLoop_); });
-
-    ret = mainLoopGuard_.EnqueueTask(mainLoopGuardTask);
-    CHECK_AND_RETURN_RET(ret == MSERR_OK, MSERR_INVALID_OPERATION);
-
-    CANCEL_SCOPE_EXIT_GUARD(0);
     return MSERR_OK;
 }
 
@@ -188,25 +173,17 @@ void RecorderMsgProcessor::AddMsgHandler(std::shared_ptr<RecorderMsgHandler> han
 
 int32_t RecorderMsgProcessor::Reset()
 {
+    // detach first, the bus callback may create the error process queue.
+    if (busWatch_ != nullptr) {
+        GstBusDispatcher::Inst().Detach(busWatch_);
+        busWatch_ = nullptr;
+    }
+
     if (errorProcQ_ != nullptr) {
         (void)errorProcQ_->Stop();
         errorProcQ_ = nullptr;
     }
 
-    if (busWatchId_ != 0) {
-        (void)g_source_remove(busWatchId_);
-        busWatchId_ = 0;
-    }
-
-    if (mainLoop_ != nullptr) {
-        if (g_main_loop_is_running(mainLoop_)) {
-            g_main_loop_quit(mainLoop_);
-        }
-        g_main_loop_unref(mainLoop_);
-        mainLoop_ = nullptr;
-    }
-
-    (void)mainLoopGuard_.Stop();
     return MSERR_OK;
 }
 
@@ -293,7 +270,7 @@ void RecorderMsgProcessor::ReportMsgProcResult(const RecorderMessage &msg)
     }
 
     if (errorProcQ_ == nullptr) {
-        errorProcQ_ = std::make_unique<TaskQueue>("rec-err-proc");
+        errorProcQ_ = std::make_unique<TaskQueue>("rec-err-proc", true);
         int32_t ret = errorProcQ_->Start();
         CHECK_AND_RETURN_LOG(ret == MSERR_OK, "unable to async process error msg !");
     }
@@ -21,6 +21,7 @@
 #include <vector>
 #include <mutex>
 #include "nocopyable.h"
+#include "gst_bus_dispatcher.h"
 #include "recorder_message_handler.h"
 #include "task_queue.h"
 
@@ -48,9 +49,7 @@ private:
     DISALLOW_COPY_AND_MOVE(RecorderMsgProcessor);
 
     GstBus *gstBus_ = nullptr;
-    GMainLoop *mainLoop_ = nullptr;
-    TaskQueue mainLoopGuard_;
-    guint busWatchId_ = 0;
+    GstBusWatch *busWatch_ = nullptr;
 
     MessageResCb msgResultCb_;
     std::vector<std::shared_ptr<RecorderMsgHandler>> msgHandlers_;
@@ -67,11 +67,12 @@ void RecorderPipelineCtrler::SetPipeline(std::shared_ptr<RecorderPipeline> pipel
 
 int32_t RecorderPipelineCtrler::Init()
 {
+    // the commands block until the pipeline changes state, they must not hold a shared executor worker
     cmdQ_ = std::make_unique<TaskQueue>("rec-pipe-ctrler-cmd");
     int32_t ret = cmdQ_->Start();
     CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
-    msgQ_ = std::make_unique<TaskQueue>("rec-pipe-ctrler-msg");
+    msgQ_ = std::make_unique<TaskQueue>("rec-pipe-ctrler-msg", true);
     ret = msgQ_->Start();
     CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
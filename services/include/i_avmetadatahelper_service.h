@@ -49,6 +49,31 @@ public:
     int32_t size_;
 };
 
+/**
+ * The layout of the shared memory returned by the FetchFramesAtTimes. The header is followed
+ * by frameCount_ offsets, each one locates a flattened OutputFrame from the beginning of the
+ * shared memory, or is -1 if the frame at that position can not be fetched.
+ */
+struct OutputFrameBatch {
+public:
+    explicit OutputFrameBatch(int32_t frameCount) : frameCount_(frameCount)
+    {
+    }
+
+    static int32_t GetHeaderSize(int32_t frameCount)
+    {
+        return static_cast<int32_t>(sizeof(OutputFrameBatch) + sizeof(int32_t) * frameCount);
+    }
+
+    int32_t *GetOffsets() const
+    {
+        uint8_t *base = const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(this));
+        return reinterpret_cast<int32_t *>(base + sizeof(OutputFrameBatch));
+    }
+
+    int32_t frameCount_;
+};
+
 struct OutputConfiguration {
     int32_t dstWidth = -1;
     int32_t dstHeight = -1;
@@ -104,6 +129,18 @@ public:
     virtual std::shared_ptr<AVSharedMemory> FetchFrameAtTime(
         int64_t timeUs, int32_t option, const OutputConfiguration &param) = 0;
 
+    /**
+     * Fetch the representative video frames near each of the given timestamps. This method
+     * must be called after the SetSource.
+     * @param timesUs The time positions in microseconds, sorted in ascending order.
+     * @param option the hint about how to fetch a frame, see {@link AVMetadataQueryOption}
+     * @param param the desired configuration of returned video frames, see {@link OutputConfiguration}.
+     * @return Returns a chunk of shared memory containing all the scaled video frames, laid out
+     * as {@link OutputFrameBatch}, which can be null, if none of the frames can be fetched.
+     */
+    virtual std::shared_ptr<AVSharedMemory> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param) = 0;
+
     /**
      * Release the internel resource. After this method called, the service instance
      * can not be used again.
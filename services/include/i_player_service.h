@@ -240,6 +240,28 @@ public:
      */
     virtual int32_t SetLooping(bool loop) = 0;
 
+    /**
+     * @brief Sets the source to play right after the current one, without the gap of a reset.
+     *
+     * @param url Indicates the playback source.
+     * @return Returns {@link MSERR_OK} if the next source is set; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetNextSource(const std::string &url) = 0;
+
+    /**
+     * @brief Sets the playback parameters, such as the read-ahead of the media data source.
+     *
+     * @param param the parameters to set.
+     * @return Returns {@link MSERR_OK} if the parameters are set; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetParameter(const Format &param) = 0;
+
     /**
      * @brief Method to set player callback.
      *
@@ -134,6 +134,26 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperServiceProxy::FetchFrameAtTime(i
     return ReadAVSharedMemoryFromParcel(reply);
 }
 
+std::shared_ptr<AVSharedMemory> AVMetadataHelperServiceProxy::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption opt;
+    (void)data.WriteInt64Vector(timesUs);
+    (void)data.WriteInt32(option);
+    (void)data.WriteInt32(param.dstWidth);
+    (void)data.WriteInt32(param.dstHeight);
+    (void)data.WriteInt32(static_cast<int32_t>(param.colorFormat));
+
+    int error = Remote()->SendRequest(FETCH_FRAMES_AT_TIMES, data, reply, opt);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("FetchFramesAtTimes failed, error: %{public}d", error);
+        return nullptr;
+    }
+    return ReadAVSharedMemoryFromParcel(reply);
+}
+
 void AVMetadataHelperServiceProxy::Release()
 {
     MessageParcel data;
@@ -31,6 +31,8 @@ public:
     std::unordered_map<int32_t, std::string> ResolveMetadataMap() override;
     std::shared_ptr<AVSharedMemory> FetchFrameAtTime(int64_t timeUs,
         int32_t option, const OutputConfiguration &param) override;
+    std::shared_ptr<AVSharedMemory> FetchFramesAtTimes(const std::vector<int64_t> &timesUs,
+        int32_t option, const OutputConfiguration &param) override;
     void Release() override;
     int32_t DestroyStub() override;
 private:
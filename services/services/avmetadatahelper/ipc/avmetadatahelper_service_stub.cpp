@@ -55,6 +55,7 @@ int32_t AVMetadataHelperServiceStub::Init()
     avMetadataHelperFuncs_[RESOLVE_METADATA] = &AVMetadataHelperServiceStub::ResolveMetadata;
     avMetadataHelperFuncs_[RESOLVE_METADATA_MAP] = &AVMetadataHelperServiceStub::ResolveMetadataMap;
     avMetadataHelperFuncs_[FETCH_FRAME_AT_TIME] = &AVMetadataHelperServiceStub::FetchFrameAtTime;
+    avMetadataHelperFuncs_[FETCH_FRAMES_AT_TIMES] = &AVMetadataHelperServiceStub::FetchFramesAtTimes;
     avMetadataHelperFuncs_[RELEASE] = &AVMetadataHelperServiceStub::Release;
     avMetadataHelperFuncs_[DESTROY] = &AVMetadataHelperServiceStub::DestroyStub;
     return MSERR_OK;
@@ -113,6 +114,13 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperServiceStub::FetchFrameAtTime(in
     return avMetadateHelperServer_->FetchFrameAtTime(timeUs, option, param);
 }
 
+std::shared_ptr<AVSharedMemory> AVMetadataHelperServiceStub::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    CHECK_AND_RETURN_RET_LOG(avMetadateHelperServer_ != nullptr, nullptr, "avmetadatahelper server is nullptr");
+    return avMetadateHelperServer_->FetchFramesAtTimes(timesUs, option, param);
+}
+
 void AVMetadataHelperServiceStub::Release()
 {
     CHECK_AND_RETURN_LOG(avMetadateHelperServer_ != nullptr, "avmetadatahelper server is nullptr");
@@ -161,6 +169,17 @@ int32_t AVMetadataHelperServiceStub::FetchFrameAtTime(MessageParcel &data, Messa
     return WriteAVSharedMemoryToParcel(ashMem, reply);
 }
 
+int32_t AVMetadataHelperServiceStub::FetchFramesAtTimes(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<int64_t> timesUs;
+    CHECK_AND_RETURN_RET_LOG(data.ReadInt64Vector(&timesUs), MSERR_INVALID_VAL, "read timestamps failed");
+    int32_t option = data.ReadInt32();
+    OutputConfiguration param = {data.ReadInt32(), data.ReadInt32(), static_cast<PixelFormat>(data.ReadInt32())};
+    std::shared_ptr<AVSharedMemory> ashMem = FetchFramesAtTimes(timesUs, option, param);
+
+    return WriteAVSharedMemoryToParcel(ashMem, reply);
+}
+
 int32_t AVMetadataHelperServiceStub::Release(MessageParcel &data, MessageParcel &reply)
 {
     Release();
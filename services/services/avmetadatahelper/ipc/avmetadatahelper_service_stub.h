@@ -35,6 +35,8 @@ public:
     std::unordered_map<int32_t, std::string> ResolveMetadataMap() override;
     std::shared_ptr<AVSharedMemory> FetchFrameAtTime(int64_t timeUs,
         int32_t option, const OutputConfiguration &param) override;
+    std::shared_ptr<AVSharedMemory> FetchFramesAtTimes(const std::vector<int64_t> &timesUs,
+        int32_t option, const OutputConfiguration &param) override;
     void Release() override;
     int32_t DestroyStub() override;
 
@@ -45,6 +47,7 @@ private:
     int32_t ResolveMetadata(MessageParcel &data, MessageParcel &reply);
     int32_t ResolveMetadataMap(MessageParcel &data, MessageParcel &reply);
     int32_t FetchFrameAtTime(MessageParcel &data, MessageParcel &reply);
+    int32_t FetchFramesAtTimes(MessageParcel &data, MessageParcel &reply);
     int32_t Release(MessageParcel &data, MessageParcel &reply);
     int32_t DestroyStub(MessageParcel &data, MessageParcel &reply);
 
@@ -48,6 +48,8 @@ public:
     virtual std::unordered_map<int32_t, std::string> ResolveMetadataMap() = 0;
     virtual std::shared_ptr<AVSharedMemory> FetchFrameAtTime(
         int64_t timeUs, int32_t option, const OutputConfiguration &param) = 0;
+    virtual std::shared_ptr<AVSharedMemory> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param) = 0;
     virtual void Release() = 0;
     virtual int32_t DestroyStub() = 0;
 
@@ -61,6 +63,7 @@ public:
         FETCH_FRAME_AT_TIME,
         RELEASE,
         DESTROY,
+        FETCH_FRAMES_AT_TIMES,
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardAVMetadataHelperService");
@@ -83,6 +83,14 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperServer::FetchFrameAtTime(int64_t
     return avMetadataHelperEngine_->FetchFrameAtTime(timeUs, option, param);
 }
 
+std::shared_ptr<AVSharedMemory> AVMetadataHelperServer::FetchFramesAtTimes(const std::vector<int64_t> &timesUs,
+    int32_t option, const OutputConfiguration &param)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(avMetadataHelperEngine_ != nullptr, nullptr, "avMetadataHelperEngine_ is nullptr");
+    return avMetadataHelperEngine_->FetchFramesAtTimes(timesUs, option, param);
+}
+
 void AVMetadataHelperServer::Release()
 {
     std::lock_guard<std::mutex> lock(mutex_);
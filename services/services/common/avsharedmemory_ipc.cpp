@@ -14,17 +14,113 @@
  */
 
 #include "avsharedmemory_ipc.h"
+#include <list>
+#include <mutex>
 #include <unistd.h>
 #include "avsharedmemorybase.h"
+#include "ipc_skeleton.h"
 #include "media_errors.h"
 #include "media_log.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVSharedMemoryIPC"};
+    constexpr size_t MAX_CACHED_MEMORIES = 16;
+    // the large memories such as the video frames are rarely sent again, do not pin them.
+    constexpr int32_t MAX_CACHED_MEMORY_SIZE = 1024 * 1024;
+    constexpr size_t MAX_CACHED_BYTES = 4 * 1024 * 1024;
 }
 
 namespace OHOS {
 namespace Media {
+class AVSharedMemoryCache {
+public:
+    static AVSharedMemoryCache &Inst()
+    {
+        static AVSharedMemoryCache inst;
+        return inst;
+    }
+
+    std::shared_ptr<AVSharedMemoryBase> Find(uint64_t token, uint64_t id, int32_t size, uint32_t flags)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+            if (iter->token_ != token || iter->id_ != id) {
+                continue;
+            }
+            std::shared_ptr<AVSharedMemoryBase> memory = iter->memory_;
+            if (memory->GetSize() != size || memory->GetFlags() != flags) {
+                bytes_ -= static_cast<size_t>(memory->GetSize());
+                entries_.erase(iter);
+                return nullptr;
+            }
+            entries_.splice(entries_.begin(), entries_, iter);
+            hitCount_++;
+            return memory;
+        }
+        return nullptr;
+    }
+
+    void Insert(uint64_t token, uint64_t id, pid_t pid, const std::shared_ptr<AVSharedMemoryBase> &memory)
+    {
+        if (id == 0 || memory->GetSize() > MAX_CACHED_MEMORY_SIZE) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        entries_.push_front({ token, id, pid, memory });
+        bytes_ += static_cast<size_t>(memory->GetSize());
+        while (entries_.size() > MAX_CACHED_MEMORIES || bytes_ > MAX_CACHED_BYTES) {
+            bytes_ -= static_cast<size_t>(entries_.back().memory_->GetSize());
+            entries_.pop_back();
+        }
+    }
+
+    void Clear()
+    {
+        std::list<CacheEntry> entries;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            MEDIA_LOGI("clear %{public}zu cached memories, hit: %{public}" PRIu64 "", entries_.size(), hitCount_);
+            std::swap(entries, entries_);
+            bytes_ = 0;
+        }
+        // unmap outside the lock
+    }
+
+    void Clear(pid_t pid)
+    {
+        std::list<CacheEntry> entries;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (auto iter = entries_.begin(); iter != entries_.end();) {
+                auto cur = iter++;
+                if (cur->pid_ == pid) {
+                    bytes_ -= static_cast<size_t>(cur->memory_->GetSize());
+                    entries.splice(entries.end(), entries_, cur);
+                }
+            }
+            MEDIA_LOGI("clear %{public}zu cached memories of pid %{public}d", entries.size(), pid);
+        }
+        // unmap outside the lock
+    }
+
+private:
+    AVSharedMemoryCache() = default;
+    ~AVSharedMemoryCache() = default;
+
+    struct CacheEntry {
+        uint64_t token_;
+        uint64_t id_;
+        pid_t pid_; // the process that sent the memory
+        std::shared_ptr<AVSharedMemoryBase> memory_;
+    };
+
+    std::mutex mutex_;
+    std::list<CacheEntry> entries_; // the most recently used at the front
+    size_t bytes_ = 0;
+    uint64_t hitCount_ = 0;
+};
+
 int32_t WriteAVSharedMemoryToParcel(const std::shared_ptr<AVSharedMemory> &memory, MessageParcel &parcel)
 {
     std::shared_ptr<AVSharedMemoryBase> baseMem = std::static_pointer_cast<AVSharedMemoryBase>(memory);
@@ -36,11 +132,14 @@ int32_t WriteAVSharedMemoryToParcel(const std::shared_ptr<AVSharedMemory> &memor
     int32_t fd = baseMem->GetFd();
     int32_t size = baseMem->GetSize();
     CHECK_AND_RETURN_RET_LOG(fd > 0 || size > 0, MSERR_INVALID_VAL, "fd or size invalid");
+    baseMem->MarkShared();
 
     (void)parcel.WriteFileDescriptor(fd);
     parcel.WriteInt32(size);
     parcel.WriteUint32(baseMem->GetFlags());
     parcel.WriteString(baseMem->GetName());
+    parcel.WriteUint64(AVSharedMemoryBase::GetToken());
+    parcel.WriteUint64(baseMem->GetId());
 
     return MSERR_OK;
 }
@@ -51,16 +150,37 @@ std::shared_ptr<AVSharedMemory> ReadAVSharedMemoryFromParcel(MessageParcel &parc
     int32_t size = parcel.ReadInt32();
     uint32_t flags = parcel.ReadUint32();
     std::string name = parcel.ReadString();
+    uint64_t token = parcel.ReadUint64();
+    uint64_t id = parcel.ReadUint64();
 
-    std::shared_ptr<AVSharedMemoryBase> memory = std::make_shared<AVSharedMemoryBase>(fd, size, flags, name);
+    // the sender passes the same memory again, reuse the mapping.
+    std::shared_ptr<AVSharedMemoryBase> memory = AVSharedMemoryCache::Inst().Find(token, id, size, flags);
+    if (memory != nullptr) {
+        (void)::close(fd);
+        return memory;
+    }
+
+    memory = std::make_shared<AVSharedMemoryBase>(fd, size, flags, name);
     int32_t ret = memory->Init();
     if (ret != MSERR_OK) {
         MEDIA_LOGE("create remote AVSharedMemoryBase failed, ret = %{public}d", ret);
         memory = nullptr;
+    } else {
+        AVSharedMemoryCache::Inst().Insert(token, id, IPCSkeleton::GetCallingPid(), memory);
     }
 
     (void)::close(fd);
     return memory;
 }
+
+void ClearAVSharedMemoryCache()
+{
+    AVSharedMemoryCache::Inst().Clear();
+}
+
+void ClearAVSharedMemoryCache(pid_t pid)
+{
+    AVSharedMemoryCache::Inst().Clear(pid);
+}
 }
 }
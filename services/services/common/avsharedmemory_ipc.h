@@ -23,7 +23,16 @@ namespace OHOS {
 namespace Media {
 [[maybe_unused]] int32_t WriteAVSharedMemoryToParcel(const std::shared_ptr<AVSharedMemory> &memory,
     MessageParcel &parcel);
+/**
+ * The receiver caches the mappings of the small memories it received, keyed by the sender and the memory id,
+ * so the same memory sent again is not mapped again. The sender does not know what the receiver has cached,
+ * so every send still transfers the fd through the binder, and a cache hit closes it right away.
+ */
 [[maybe_unused]] std::shared_ptr<AVSharedMemory> ReadAVSharedMemoryFromParcel(MessageParcel &parcel);
+// drop the cached mappings of the received memories, must be called when the sender process died.
+[[maybe_unused]] void ClearAVSharedMemoryCache();
+// drop the cached mappings of the memories received from the given process in a binder call.
+[[maybe_unused]] void ClearAVSharedMemoryCache(pid_t pid);
 }
 }
 #endif
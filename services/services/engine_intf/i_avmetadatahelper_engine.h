@@ -69,6 +69,19 @@ public:
      */
     virtual std::shared_ptr<AVSharedMemory> FetchFrameAtTime(
         int64_t timeUs, int32_t option, const OutputConfiguration &param) = 0;
+
+    /**
+     * Fetch the representative video frames near each of the given timestamps. The timestamps
+     * are visited in ascending order so that the nearby ones share the decoder state. This
+     * method must be called after the SetSource.
+     * @param timesUs The time positions in microseconds, sorted in ascending order.
+     * @param option the hint about how to fetch a frame, see {@link AVMetadataQueryOption}
+     * @param param the desired configuration of returned video frames, see {@link OutputConfiguration}.
+     * @return Returns a chunk of shared memory containing all the scaled video frames, laid out
+     * as {@link OutputFrameBatch}, which can be null, if none of the frames can be fetched.
+     */
+    virtual std::shared_ptr<AVSharedMemory> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param) = 0;
 };
 }
 }
@@ -54,6 +54,8 @@ public:
     virtual int32_t GetPlaybackSpeed(PlaybackRateMode &mode) = 0;
     virtual int32_t SetVideoSurface(sptr<Surface> surface) = 0;
     virtual int32_t SetLooping(bool loop) = 0;
+    virtual int32_t SetParameter(const Format &param) = 0;
+    virtual int32_t SetNextSource(const std::string &url) = 0;
     virtual int32_t SetObs(const std::weak_ptr<IPlayerEngineObs> &obs) = 0;
 };
 } // Media
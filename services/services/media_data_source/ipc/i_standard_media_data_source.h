@@ -31,11 +31,25 @@ public:
     virtual int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) = 0;
     virtual int32_t ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) = 0;
     virtual int32_t GetSize(int64_t &size) = 0;
+    /**
+     * Register a long-lived shared ring made of fixed-size slots. After this, reads can be issued
+     * with ReadAtSlot, which only carries a small descriptor instead of a file descriptor.
+     */
+    virtual int32_t SetShmRing(const std::shared_ptr<AVSharedMemory> &ring, uint32_t slotSize) = 0;
+    /**
+     * Read into the given slot of the registered ring. pos is RING_READ_NO_POS for the
+     * stream data source which has no position.
+     */
+    virtual int32_t ReadAtSlot(uint32_t slot, int64_t pos, uint32_t length) = 0;
+
+    static constexpr int64_t RING_READ_NO_POS = -1;
 
     enum ListenerMsg {
         READ_AT = 0,
         READ_AT_POS,
         GET_SIZE,
+        SET_SHM_RING,
+        READ_AT_SLOT,
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardMediaDataSource");
@@ -17,9 +17,14 @@
 #include "media_log.h"
 #include "media_errors.h"
 #include "avsharedmemory_ipc.h"
+#include "securec.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaDataSourceProxy"};
+constexpr uint32_t RING_SLOT_NUM = 8;
+constexpr uint32_t RING_SLOT_SIZE = 131072;
+// all the slots are held by reads the client does not answer, give up instead of blocking the fill forever
+constexpr int32_t SLOT_WAIT_TIMEOUT_MS = 5000;
 }
 
 namespace OHOS {
@@ -35,15 +40,83 @@ MediaDataCallback::~MediaDataCallback()
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
 }
 
+int32_t MediaDataCallback::Init()
+{
+    CHECK_AND_RETURN_RET_LOG(callbackProxy_ != nullptr, MSERR_INVALID_OPERATION, "callbackProxy_ is nullptr");
+    std::shared_ptr<AVSharedMemory> ring = AVSharedMemory::Create(static_cast<int32_t>(RING_SLOT_NUM * RING_SLOT_SIZE),
+        AVSharedMemory::Flags::FLAGS_READ_WRITE, "datasrc_ring");
+    CHECK_AND_RETURN_RET_LOG(ring != nullptr, MSERR_NO_MEMORY, "create shared ring failed");
+
+    int32_t ret = callbackProxy_->SetShmRing(ring, RING_SLOT_SIZE);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "register shared ring failed");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ring_ = ring;
+    slotSize_ = RING_SLOT_SIZE;
+    for (uint32_t i = 0; i < RING_SLOT_NUM; ++i) {
+        freeSlots_.push(i);
+    }
+    MEDIA_LOGI("shared ring registered, slot num %{public}u, slot size %{public}u", RING_SLOT_NUM, RING_SLOT_SIZE);
+    return MSERR_OK;
+}
+
+bool MediaDataCallback::AcquireSlot(uint32_t &slot)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!slotCond_.wait_for(lock, std::chrono::milliseconds(SLOT_WAIT_TIMEOUT_MS),
+        [this] { return !freeSlots_.empty(); })) {
+        MEDIA_LOGE("no free slot in %{public}d ms, the client does not answer the reads", SLOT_WAIT_TIMEOUT_MS);
+        return false;
+    }
+    slot = freeSlots_.front();
+    freeSlots_.pop();
+    return true;
+}
+
+void MediaDataCallback::ReleaseSlot(uint32_t slot)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    freeSlots_.push(slot);
+    slotCond_.notify_one();
+}
+
+int32_t MediaDataCallback::ReadAtRing(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem)
+{
+    CHECK_AND_RETURN_RET_LOG(mem != nullptr && mem->GetBase() != nullptr, SOURCE_ERROR_IO, "mem is nullptr");
+    uint32_t slot = 0;
+    CHECK_AND_RETURN_RET(AcquireSlot(slot), SOURCE_ERROR_IO);
+    int32_t realLen = callbackProxy_->ReadAtSlot(slot, pos, length);
+    if (realLen > 0) {
+        // the ring only saves mapping a new ashmem for every read, the data is still copied once into mem,
+        // as the slot goes back to the ring right away while mem is owned by the caller.
+        int32_t copyLen = std::min(realLen, std::min(static_cast<int32_t>(length), mem->GetSize()));
+        uint8_t *src = ring_->GetBase() + static_cast<size_t>(slot) * slotSize_;
+        if (memcpy_s(mem->GetBase(), static_cast<size_t>(mem->GetSize()), src, static_cast<size_t>(copyLen)) != EOK) {
+            MEDIA_LOGE("copy from shared ring failed");
+            realLen = SOURCE_ERROR_IO;
+        } else {
+            realLen = copyLen;
+        }
+    }
+    ReleaseSlot(slot);
+    return realLen;
+}
+
 int32_t MediaDataCallback::ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem)
 {
     CHECK_AND_RETURN_RET_LOG(callbackProxy_ != nullptr, SOURCE_ERROR_IO, "callbackProxy_ is nullptr");
+    if (ring_ != nullptr && length <= slotSize_) {
+        return ReadAtRing(IStandardMediaDataSource::RING_READ_NO_POS, length, mem);
+    }
     return callbackProxy_->ReadAt(length, mem);
 }
 
 int32_t MediaDataCallback::ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem)
 {
     CHECK_AND_RETURN_RET_LOG(callbackProxy_ != nullptr, SOURCE_ERROR_IO, "callbackProxy_ is nullptr");
+    if (ring_ != nullptr && length <= slotSize_) {
+        return ReadAtRing(pos, length, mem);
+    }
     return callbackProxy_->ReadAt(pos, length, mem);
 }
 
@@ -108,5 +181,37 @@ int32_t MediaDataSourceProxy::GetSize(int64_t &size)
     size = reply.ReadInt64();
     return reply.ReadInt32();
 }
+
+int32_t MediaDataSourceProxy::SetShmRing(const std::shared_ptr<AVSharedMemory> &ring, uint32_t slotSize)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+    CHECK_AND_RETURN_RET_LOG(WriteAVSharedMemoryToParcel(ring, data) == MSERR_OK, MSERR_INVALID_VAL,
+        "write parcel failed");
+    data.WriteUint32(slotSize);
+    int error = Remote()->SendRequest(ListenerMsg::SET_SHM_RING, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("SetShmRing failed, error: %{public}d", error);
+        return MSERR_INVALID_OPERATION;
+    }
+    return reply.ReadInt32();
+}
+
+int32_t MediaDataSourceProxy::ReadAtSlot(uint32_t slot, int64_t pos, uint32_t length)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+    data.WriteUint32(slot);
+    data.WriteInt64(pos);
+    data.WriteUint32(length);
+    int error = Remote()->SendRequest(ListenerMsg::READ_AT_SLOT, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("ReadAtSlot failed, error: %{public}d", error);
+        return 0;
+    }
+    return reply.ReadInt32();
+}
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
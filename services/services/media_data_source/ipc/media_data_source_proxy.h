@@ -16,6 +16,9 @@
 #ifndef MEDIA_DATA_SOURCE_PROXY_H
 #define MEDIA_DATA_SOURCE_PROXY_H
 
+#include <condition_variable>
+#include <mutex>
+#include <queue>
 #include "i_standard_media_data_source.h"
 #include "media_death_recipient.h"
 #include "nocopyable.h"
@@ -27,12 +30,22 @@ public:
     explicit MediaDataCallback(const sptr<IStandardMediaDataSource> &proxy);
     virtual ~MediaDataCallback();
     DISALLOW_COPY_AND_MOVE(MediaDataCallback);
+    int32_t Init();
     int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
     int32_t ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
     int32_t GetSize(int64_t &size) override;
 
 private:
+    int32_t ReadAtRing(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem);
+    bool AcquireSlot(uint32_t &slot);
+    void ReleaseSlot(uint32_t slot);
+
     sptr<IStandardMediaDataSource> callbackProxy_ = nullptr;
+    std::shared_ptr<AVSharedMemory> ring_ = nullptr;
+    uint32_t slotSize_ = 0;
+    std::mutex mutex_;
+    std::condition_variable slotCond_;
+    std::queue<uint32_t> freeSlots_;
 };
 
 class MediaDataSourceProxy : public IRemoteProxy<IStandardMediaDataSource> {
@@ -43,6 +56,8 @@ public:
     int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
     int32_t ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
     int32_t GetSize(int64_t &size) override;
+    int32_t SetShmRing(const std::shared_ptr<AVSharedMemory> &ring, uint32_t slotSize) override;
+    int32_t ReadAtSlot(uint32_t slot, int64_t pos, uint32_t length) override;
 
 private:
     static inline BrokerDelegator<MediaDataSourceProxy> delegator_;
@@ -25,6 +25,40 @@ constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaDataS
 
 namespace OHOS {
 namespace Media {
+/**
+ * A view on one slot of the registered shared ring. It keeps the ring mapping alive and
+ * is handed to the data source in place of a per-read mapped memory.
+ */
+class MediaDataRingSlot : public AVSharedMemory {
+public:
+    MediaDataRingSlot(const std::shared_ptr<AVSharedMemory> &ring, uint32_t offset, uint32_t size)
+        : ring_(ring), offset_(offset), size_(size)
+    {
+    }
+    ~MediaDataRingSlot() = default;
+    DISALLOW_COPY_AND_MOVE(MediaDataRingSlot);
+
+    uint8_t *GetBase() override
+    {
+        return ring_->GetBase() + offset_;
+    }
+
+    int32_t GetSize() override
+    {
+        return static_cast<int32_t>(size_);
+    }
+
+    uint32_t GetFlags() override
+    {
+        return ring_->GetFlags();
+    }
+
+private:
+    std::shared_ptr<AVSharedMemory> ring_;
+    uint32_t offset_;
+    uint32_t size_;
+};
+
 MediaDataSourceStub::MediaDataSourceStub(const std::shared_ptr<IMediaDataSource> &dataSrc)
     : dataSrc_(dataSrc)
 {
@@ -62,6 +96,19 @@ int MediaDataSourceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Mes
             reply.WriteInt32(ret);
             return MSERR_OK;
         }
+        case ListenerMsg::SET_SHM_RING: {
+            std::shared_ptr<AVSharedMemory> ring = ReadAVSharedMemoryFromParcel(data);
+            uint32_t slotSize = data.ReadUint32();
+            reply.WriteInt32(SetShmRing(ring, slotSize));
+            return MSERR_OK;
+        }
+        case ListenerMsg::READ_AT_SLOT: {
+            uint32_t slot = data.ReadUint32();
+            int64_t pos = data.ReadInt64();
+            uint32_t length = data.ReadUint32();
+            reply.WriteInt32(ReadAtSlot(slot, pos, length));
+            return MSERR_OK;
+        }
         default: {
             MEDIA_LOGE("default case, need check MediaDataSourceStub");
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -86,5 +133,36 @@ int32_t MediaDataSourceStub::GetSize(int64_t &size)
     CHECK_AND_RETURN_RET_LOG(dataSrc_ != nullptr, MSERR_INVALID_OPERATION, "dataSrc_ is nullptr");
     return dataSrc_->GetSize(size);
 }
+
+int32_t MediaDataSourceStub::SetShmRing(const std::shared_ptr<AVSharedMemory> &ring, uint32_t slotSize)
+{
+    CHECK_AND_RETURN_RET_LOG(ring != nullptr && ring->GetBase() != nullptr, MSERR_INVALID_VAL, "ring is nullptr");
+    CHECK_AND_RETURN_RET_LOG(slotSize > 0 && static_cast<uint32_t>(ring->GetSize()) >= slotSize,
+        MSERR_INVALID_VAL, "invalid slot size %{public}u", slotSize);
+
+    uint32_t slotNum = static_cast<uint32_t>(ring->GetSize()) / slotSize;
+    std::vector<std::shared_ptr<AVSharedMemory>> slots;
+    for (uint32_t i = 0; i < slotNum; ++i) {
+        std::shared_ptr<AVSharedMemory> slotMem = std::make_shared<MediaDataRingSlot>(ring, i * slotSize, slotSize);
+        CHECK_AND_RETURN_RET_LOG(slotMem != nullptr, MSERR_NO_MEMORY, "create ring slot failed");
+        slots.push_back(slotMem);
+    }
+    ring_ = ring;
+    slots_.swap(slots);
+    MEDIA_LOGI("shared ring mapped, slot num %{public}u, slot size %{public}u", slotNum, slotSize);
+    return MSERR_OK;
+}
+
+int32_t MediaDataSourceStub::ReadAtSlot(uint32_t slot, int64_t pos, uint32_t length)
+{
+    CHECK_AND_RETURN_RET_LOG(slot < slots_.size(), SOURCE_ERROR_IO, "invalid slot %{public}u", slot);
+    std::shared_ptr<AVSharedMemory> &slotMem = slots_[slot];
+    CHECK_AND_RETURN_RET_LOG(length <= static_cast<uint32_t>(slotMem->GetSize()), SOURCE_ERROR_IO,
+        "length %{public}u exceed slot size", length);
+    if (pos == RING_READ_NO_POS) {
+        return ReadAt(length, slotMem);
+    }
+    return ReadAt(pos, length, slotMem);
+}
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -16,6 +16,7 @@
 #ifndef MEDIA_DATA_SOURCE_STUB_H
 #define MEDIA_DATA_SOURCE_STUB_H
 
+#include <vector>
 #include "i_standard_media_data_source.h"
 #include "media_death_recipient.h"
 #include "nocopyable.h"
@@ -31,9 +32,13 @@ public:
     int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
     int32_t ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) override;
     int32_t GetSize(int64_t &size) override;
+    int32_t SetShmRing(const std::shared_ptr<AVSharedMemory> &ring, uint32_t slotSize) override;
+    int32_t ReadAtSlot(uint32_t slot, int64_t pos, uint32_t length) override;
 
 private:
     std::shared_ptr<IMediaDataSource> dataSrc_ = nullptr;
+    std::shared_ptr<AVSharedMemory> ring_ = nullptr;
+    std::vector<std::shared_ptr<AVSharedMemory>> slots_;
 };
 } // namespace Media
 } // namespace OHOS
@@ -47,6 +47,8 @@ public:
     virtual bool IsPlaying() = 0;
     virtual bool IsLooping() = 0;
     virtual int32_t SetLooping(bool loop) = 0;
+    virtual int32_t SetParameter(const Format &param) = 0;
+    virtual int32_t SetNextSource(const std::string &url) = 0;
     virtual int32_t DestroyStub() = 0;
     virtual int32_t SetPlayerCallback() = 0;
 
@@ -76,6 +78,8 @@ public:
         SET_LOOPING,
         DESTROY,
         SET_CALLBACK,
+        SET_PARAMETER,
+        SET_NEXT_SOURCE,
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardPlayerService");
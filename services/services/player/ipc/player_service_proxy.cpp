@@ -15,6 +15,7 @@
 
 #include "player_service_proxy.h"
 #include "player_listener_stub.h"
+#include "media_parcel.h"
 #include "media_log.h"
 #include "media_errors.h"
 
@@ -325,6 +326,34 @@ int32_t PlayerServiceProxy::SetLooping(bool loop)
     return reply.ReadInt32();
 }
 
+int32_t PlayerServiceProxy::SetParameter(const Format &param)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    CHECK_AND_RETURN_RET_LOG(MediaParcel::Marshalling(data, param), MSERR_INVALID_VAL, "write parameter failed");
+    int error = Remote()->SendRequest(SET_PARAMETER, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("Set parameter failed, error: %{public}d", error);
+        return error;
+    }
+    return reply.ReadInt32();
+}
+
+int32_t PlayerServiceProxy::SetNextSource(const std::string &url)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    data.WriteString(url);
+    int error = Remote()->SendRequest(SET_NEXT_SOURCE, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("Set next source failed, error: %{public}d", error);
+        return error;
+    }
+    return reply.ReadInt32();
+}
+
 int32_t PlayerServiceProxy::DestroyStub()
 {
     MessageParcel data;
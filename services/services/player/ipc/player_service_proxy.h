@@ -44,6 +44,8 @@ public:
     bool IsPlaying() override;
     bool IsLooping() override;
     int32_t SetLooping(bool loop) override;
+    int32_t SetNextSource(const std::string &url) override;
+    int32_t SetParameter(const Format &param) override;
     int32_t DestroyStub() override;
     int32_t SetPlayerCallback() override;
 
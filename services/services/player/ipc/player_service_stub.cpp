@@ -17,6 +17,7 @@
 #include "player_listener_proxy.h"
 #include "media_data_source_proxy.h"
 #include "media_server_manager.h"
+#include "media_parcel.h"
 #include "media_log.h"
 #include "media_errors.h"
 
@@ -73,6 +74,8 @@ int32_t PlayerServiceStub::Init()
     playerFuncs_[SET_LOOPING] = &PlayerServiceStub::SetLooping;
     playerFuncs_[DESTROY] = &PlayerServiceStub::DestroyStub;
     playerFuncs_[SET_CALLBACK] = &PlayerServiceStub::SetPlayerCallback;
+    playerFuncs_[SET_PARAMETER] = &PlayerServiceStub::SetParameter;
+    playerFuncs_[SET_NEXT_SOURCE] = &PlayerServiceStub::SetNextSource;
     return MSERR_OK;
 }
 
@@ -134,8 +137,11 @@ int32_t PlayerServiceStub::SetSource(const sptr<IRemoteObject> &object)
     sptr<IStandardMediaDataSource> proxy = iface_cast<IStandardMediaDataSource>(object);
     CHECK_AND_RETURN_RET_LOG(proxy != nullptr, MSERR_NO_MEMORY, "failed to convert MeidaDataSourceProxy");
 
-    std::shared_ptr<IMediaDataSource> mediaDataSrc = std::make_shared<MediaDataCallback>(proxy);
+    std::shared_ptr<MediaDataCallback> mediaDataSrc = std::make_shared<MediaDataCallback>(proxy);
     CHECK_AND_RETURN_RET_LOG(mediaDataSrc != nullptr, MSERR_NO_MEMORY, "failed to new PlayerListenerCallback");
+    if (mediaDataSrc->Init() != MSERR_OK) {
+        MEDIA_LOGW("shared ring unavailable, fall back to per read memory passing");
+    }
 
     return playerServer_->SetSource(mediaDataSrc);
 }
@@ -243,6 +249,18 @@ int32_t PlayerServiceStub::SetLooping(bool loop)
     return playerServer_->SetLooping(loop);
 }
 
+int32_t PlayerServiceStub::SetParameter(const Format &param)
+{
+    CHECK_AND_RETURN_RET_LOG(playerServer_ != nullptr, MSERR_NO_MEMORY, "player server is nullptr");
+    return playerServer_->SetParameter(param);
+}
+
+int32_t PlayerServiceStub::SetNextSource(const std::string &url)
+{
+    CHECK_AND_RETURN_RET_LOG(playerServer_ != nullptr, MSERR_NO_MEMORY, "player server is nullptr");
+    return playerServer_->SetNextSource(url);
+}
+
 int32_t PlayerServiceStub::SetPlayerCallback()
 {
     MEDIA_LOGD("SetPlayerCallback");
@@ -411,6 +429,21 @@ int32_t PlayerServiceStub::SetLooping(MessageParcel &data, MessageParcel &reply)
     return MSERR_OK;
 }
 
+int32_t PlayerServiceStub::SetParameter(MessageParcel &data, MessageParcel &reply)
+{
+    Format param;
+    CHECK_AND_RETURN_RET_LOG(MediaParcel::Unmarshalling(data, param), MSERR_INVALID_VAL, "read parameter failed");
+    reply.WriteInt32(SetParameter(param));
+    return MSERR_OK;
+}
+
+int32_t PlayerServiceStub::SetNextSource(MessageParcel &data, MessageParcel &reply)
+{
+    std::string url = data.ReadString();
+    reply.WriteInt32(SetNextSource(url));
+    return MSERR_OK;
+}
+
 int32_t PlayerServiceStub::DestroyStub(MessageParcel &data, MessageParcel &reply)
 {
     (void)data;
@@ -490,6 +490,39 @@ int32_t PlayerServer::SetLooping(bool loop)
     return MSERR_OK;
 }
 
+int32_t PlayerServer::SetNextSource(const std::string &url)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((status_ != PLAYER_PREPARED) && (status_ != PLAYER_STARTED) && (status_ != PLAYER_PAUSED)) {
+        MEDIA_LOGE("Can not SetNextSource, currentState is %{public}d", status_);
+        return MSERR_INVALID_OPERATION;
+    }
+
+    if (dataSrc_ != nullptr) {
+        MEDIA_LOGE("Can not SetNextSource, it is playing the media data source");
+        return MSERR_INVALID_OPERATION;
+    }
+
+    CHECK_AND_RETURN_RET_LOG(playerEngine_ != nullptr, MSERR_NO_MEMORY, "playerEngine_ is nullptr");
+    int32_t ret = playerEngine_->SetNextSource(url);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "SetNextSource Failed!");
+    return MSERR_OK;
+}
+
+int32_t PlayerServer::SetParameter(const Format &param)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (status_ != PLAYER_INITIALIZED) {
+        MEDIA_LOGE("Can not SetParameter, currentState is %{public}d", status_);
+        return MSERR_INVALID_OPERATION;
+    }
+
+    CHECK_AND_RETURN_RET_LOG(playerEngine_ != nullptr, MSERR_NO_MEMORY, "playerEngine_ is nullptr");
+    int32_t ret = playerEngine_->SetParameter(param);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "SetParameter Failed!");
+    return MSERR_OK;
+}
+
 int32_t PlayerServer::SetPlayerCallback(const std::shared_ptr<PlayerCallback> &callback)
 {
     std::lock_guard<std::mutex> lock(mutex_);
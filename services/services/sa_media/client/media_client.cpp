@@ -21,6 +21,7 @@
 #include "i_standard_recorder_service.h"
 #include "i_standard_player_service.h"
 #include "i_standard_avmetadatahelper_service.h"
+#include "avsharedmemory_ipc.h"
 #include "media_log.h"
 #include "media_errors.h"
 
@@ -199,6 +200,7 @@ void MediaClient::MediaServerDied(pid_t pid)
     mediaProxy_ = nullptr;
     listenerStub_ = nullptr;
     deathRecipient_ = nullptr;
+    ClearAVSharedMemoryCache();
 
     for (auto &it : recorderClientList_) {
         auto recorder = std::static_pointer_cast<RecorderClient>(it);
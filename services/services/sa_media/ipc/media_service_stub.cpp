@@ -17,6 +17,7 @@
 #include "media_log.h"
 #include "media_errors.h"
 #include "media_server_manager.h"
+#include "avsharedmemory_ipc.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaServiceStub"};
@@ -112,6 +113,7 @@ void MediaServiceStub::ClientDied(pid_t pid)
 {
     MEDIA_LOGE("client pid is dead, pid:%{public}d", pid);
     (void)DestroyStubForPid(pid);
+    ClearAVSharedMemoryCache(pid);
 }
 
 int32_t MediaServiceStub::SetListenerObject(const sptr<IRemoteObject> &object)
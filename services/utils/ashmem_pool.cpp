@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ashmem_pool.h"
+#include <chrono>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "securec.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AshmemPool"};
+    constexpr size_t ASHMEM_PAGE_SIZE = 4096;
+    // 4 classes per power of two, wastes at most 25% of the capacity.
+    constexpr uint32_t CLASS_SHIFT = 2;
+    constexpr size_t MAX_POOLED_REGION_SIZE = 16 * 1024 * 1024;
+    constexpr size_t MAX_POOLED_BYTES = 32 * 1024 * 1024;
+    constexpr uint64_t REGION_IDLE_TIMEOUT_NS = 10000000000; // 10s
+    constexpr uint64_t TRIM_INTERVAL_NS = 1000000000; // 1s
+    constexpr uint64_t STATISTICS_INTERVAL = 1024;
+
+    uint64_t GetCurrentTimeNs()
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+}
+
+namespace OHOS {
+namespace Media {
+AshmemPool &AshmemPool::Inst()
+{
+    // never destroyed, the memories may be still released at the process exit.
+    static AshmemPool *inst = new AshmemPool();
+    return *inst;
+}
+
+size_t AshmemPool::GetCapacity(size_t size)
+{
+    if (size == 0 || size > MAX_POOLED_REGION_SIZE) {
+        return size;
+    }
+
+    size_t pages = (size + ASHMEM_PAGE_SIZE - 1) / ASHMEM_PAGE_SIZE;
+    if (pages <= (1u << CLASS_SHIFT)) {
+        return pages * ASHMEM_PAGE_SIZE;
+    }
+
+    uint32_t log2 = static_cast<uint32_t>(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(pages));
+    size_t unit = static_cast<size_t>(1) << (log2 - CLASS_SHIFT);
+    return (pages + unit - 1) / unit * unit * ASHMEM_PAGE_SIZE;
+}
+
+bool AshmemPool::Acquire(size_t size, AshmemRegion &region)
+{
+    size_t capacity = GetCapacity(size);
+    if (capacity > MAX_POOLED_REGION_SIZE) {
+        return false;
+    }
+
+    std::vector<AshmemRegion> expired;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        acquireCount_++;
+        if (acquireCount_ % STATISTICS_INTERVAL == 0) {
+            DumpStatisticsLocked();
+        }
+
+        auto iter = freeRegions_.find(capacity);
+        if (iter == freeRegions_.end() || iter->second.empty()) {
+            TrimLocked(GetCurrentTimeNs(), expired);
+            lock.unlock();
+            Destroy(expired);
+            return false;
+        }
+
+        region = iter->second.back().region_;
+        iter->second.pop_back();
+        pooledBytes_ -= capacity;
+        hitCount_++;
+    }
+
+    // the region may be shared to another process by the new owner, never leak the stale content.
+    if (region.dirtySize_ > 0) {
+        (void)memset_s(region.base_, region.capacity_, 0, region.dirtySize_);
+    }
+    region.dirtySize_ = size;
+    return true;
+}
+
+bool AshmemPool::Release(const AshmemRegion &region)
+{
+    if (region.fd_ <= 0 || region.base_ == nullptr || region.capacity_ > MAX_POOLED_REGION_SIZE ||
+        GetCapacity(region.capacity_) != region.capacity_) {
+        return false;
+    }
+
+    std::vector<AshmemRegion> expired;
+    bool accepted = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        uint64_t curTimeNs = GetCurrentTimeNs();
+        TrimLocked(curTimeNs, expired);
+
+        releaseCount_++;
+        if (pooledBytes_ + region.capacity_ <= MAX_POOLED_BYTES) {
+            freeRegions_[region.capacity_].push_back({region, curTimeNs});
+            pooledBytes_ += region.capacity_;
+            accepted = true;
+        } else {
+            dropCount_++;
+        }
+    }
+
+    Destroy(expired);
+    return accepted;
+}
+
+void AshmemPool::TrimLocked(uint64_t curTimeNs, std::vector<AshmemRegion> &expired)
+{
+    if (curTimeNs - lastTrimTimeNs_ < TRIM_INTERVAL_NS) {
+        return;
+    }
+    lastTrimTimeNs_ = curTimeNs;
+
+    for (auto iter = freeRegions_.begin(); iter != freeRegions_.end();) {
+        auto &regions = iter->second;
+        // the earliest released at the front
+        size_t count = 0;
+        while (count < regions.size() && curTimeNs - regions[count].releaseTimeNs_ >= REGION_IDLE_TIMEOUT_NS) {
+            expired.push_back(regions[count].region_);
+            pooledBytes_ -= regions[count].region_.capacity_;
+            count++;
+        }
+        regions.erase(regions.begin(), regions.begin() + static_cast<std::ptrdiff_t>(count));
+        iter = regions.empty() ? freeRegions_.erase(iter) : std::next(iter);
+    }
+}
+
+void AshmemPool::Destroy(const std::vector<AshmemRegion> &regions)
+{
+    for (auto &region : regions) {
+        (void)::munmap(region.base_, region.capacity_);
+        (void)::close(region.fd_);
+    }
+}
+
+void AshmemPool::DumpStatisticsLocked() const
+{
+    MEDIA_LOGI("acquire: %{public}" PRIu64 ", hit: %{public}" PRIu64 " (%{public}" PRIu64 "%%), "
+               "release: %{public}" PRIu64 ", drop: %{public}" PRIu64 ", pooled: %{public}zu bytes",
+               acquireCount_, hitCount_, hitCount_ * 100 / acquireCount_, releaseCount_, dropCount_, pooledBytes_);
+}
+}
+}
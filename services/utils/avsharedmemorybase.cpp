@@ -14,15 +14,19 @@
  */
 
 #include "avsharedmemorybase.h"
+#include <atomic>
+#include <chrono>
 #include <sys/mman.h>
 #include <unistd.h>
 #include "ashmem.h"
+#include "ashmem_pool.h"
 #include "media_errors.h"
 #include "media_log.h"
 #include "scope_guard.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVSharedMemoryBase"};
+    std::atomic<uint64_t> g_nextMemoryId = 1;
 }
 
 namespace OHOS {
@@ -40,7 +44,7 @@ std::shared_ptr<AVSharedMemory> AVSharedMemory::Create(int32_t size, uint32_t fl
 }
 
 AVSharedMemoryBase::AVSharedMemoryBase(int32_t size, uint32_t flags, const std::string &name)
-    : base_(nullptr), size_(size), flags_(flags), name_(name), fd_(-1)
+    : base_(nullptr), size_(size), flags_(flags), name_(name), fd_(-1), id_(g_nextMemoryId++)
 {
     MEDIA_LOGD("enter ctor, instance: 0x%{public}06" PRIXPTR ", name = %{public}s",
                FAKE_POINTER(this), name_.c_str());
@@ -53,6 +57,21 @@ AVSharedMemoryBase::AVSharedMemoryBase(int32_t fd, int32_t size, uint32_t flags,
                FAKE_POINTER(this), name_.c_str());
 }
 
+uint64_t AVSharedMemoryBase::GetToken()
+{
+    /**
+     * This file may be built into several libraries of one process, each with its own id counter. The counter's
+     * address distinguishes them, and the start time distinguishes the processes that reuse the same pid.
+     */
+    static const uint64_t token = [] {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        uint64_t nowNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        constexpr uint32_t pidShift = 32;
+        return (static_cast<uint64_t>(getpid()) << pidShift) ^ nowNs ^ reinterpret_cast<uintptr_t>(&g_nextMemoryId);
+    }();
+    return token;
+}
+
 AVSharedMemoryBase::~AVSharedMemoryBase()
 {
     MEDIA_LOGD("enter dtor, instance: 0x%{public}06" PRIXPTR ", name = %{public}s",
@@ -71,19 +90,30 @@ int32_t AVSharedMemoryBase::Init()
 
     CHECK_AND_RETURN_RET(size_ > 0, MSERR_INVALID_VAL);
 
-    bool isRemote = false;
     if (fd_ > 0) {
+        // the pooled region may be larger than the memory size.
         int size = AshmemGetSize(fd_);
-        CHECK_AND_RETURN_RET(size == size_, MSERR_INVALID_VAL);
-        isRemote = true;
+        CHECK_AND_RETURN_RET(size >= size_, MSERR_INVALID_VAL);
+        isRemote_ = true;
+        capacity_ = static_cast<size_t>(size_);
     }
 
     if (fd_ <= 0) {
-        fd_ = AshmemCreate(name_.c_str(), static_cast<size_t>(size_));
+        AshmemRegion region;
+        if (AshmemPool::Inst().Acquire(static_cast<size_t>(size_), region)) {
+            fd_ = region.fd_;
+            base_ = region.base_;
+            capacity_ = region.capacity_;
+            CANCEL_SCOPE_EXIT_GUARD(0);
+            return MSERR_OK;
+        }
+
+        capacity_ = AshmemPool::GetCapacity(static_cast<size_t>(size_));
+        fd_ = AshmemCreate(name_.c_str(), capacity_);
         CHECK_AND_RETURN_RET(fd_ > 0, MSERR_INVALID_VAL);
     }
 
-    int32_t ret = MapMemory(isRemote);
+    int32_t ret = MapMemory(isRemote_);
     CHECK_AND_RETURN_RET(ret == MSERR_OK, MSERR_INVALID_VAL);
 
     CANCEL_SCOPE_EXIT_GUARD(0);
@@ -100,7 +130,7 @@ int32_t AVSharedMemoryBase::MapMemory(bool isRemote)
     int result = AshmemSetProt(fd_, static_cast<int>(prot));
     CHECK_AND_RETURN_RET(result >= 0, MSERR_INVALID_OPERATION);
 
-    void *addr = ::mmap(nullptr, static_cast<size_t>(size_), static_cast<int>(prot), MAP_SHARED, fd_, 0);
+    void *addr = ::mmap(nullptr, capacity_, static_cast<int>(prot), MAP_SHARED, fd_, 0);
     CHECK_AND_RETURN_RET(addr != MAP_FAILED, MSERR_INVALID_OPERATION);
 
     base_ = reinterpret_cast<uint8_t*>(addr);
@@ -109,8 +139,19 @@ int32_t AVSharedMemoryBase::MapMemory(bool isRemote)
 
 void AVSharedMemoryBase::Close() noexcept
 {
+    if (base_ != nullptr && !isRemote_ && !isShared_) {
+        AshmemRegion region = { fd_, base_, capacity_, static_cast<size_t>(size_) };
+        if (AshmemPool::Inst().Release(region)) {
+            base_ = nullptr;
+            size_ = 0;
+            flags_ = 0;
+            fd_ = -1;
+            return;
+        }
+    }
+
     if (base_ != nullptr) {
-        (void)::munmap(base_, static_cast<size_t>(size_));
+        (void)::munmap(base_, capacity_);
         base_ = nullptr;
         size_ = 0;
         flags_ = 0;
@@ -141,5 +182,10 @@ int32_t AVSharedMemoryBase::GetFd() const
 {
     return fd_;
 }
+
+void AVSharedMemoryBase::MarkShared()
+{
+    isShared_ = true;
+}
 }
 }
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASHMEM_POOL_H
+#define ASHMEM_POOL_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+struct AshmemRegion {
+    int32_t fd_ = -1;
+    uint8_t *base_ = nullptr;
+    size_t capacity_ = 0;
+    // the leading bytes that may have been written since the region was created.
+    size_t dirtySize_ = 0;
+};
+
+/**
+ * Process-wide pool of the mapped ashmem regions. The regions are grouped by the size class, the released
+ * region is kept mapped and reused by the next acquire of the same class, so that the steady-state pipelines
+ * do not create and map the ashmem for each buffer.
+ *
+ * Only the region that is never shared to the remote process can be released to the pool, because the
+ * remote process may be still reading it, and may have narrowed its protection.
+ */
+class __attribute__((visibility("default"))) AshmemPool {
+public:
+    static AshmemPool &Inst();
+
+    // the capacity to create the region with for the size, only such a region can be released to the pool.
+    static size_t GetCapacity(size_t size);
+    // acquire a pooled region for the size, the previously written bytes are zeroed.
+    bool Acquire(size_t size, AshmemRegion &region);
+    // the caller must unmap and close the region by itself if not accepted.
+    bool Release(const AshmemRegion &region);
+
+    DISALLOW_COPY_AND_MOVE(AshmemPool);
+
+private:
+    AshmemPool() = default;
+    ~AshmemPool() = default;
+
+    struct PooledRegion {
+        AshmemRegion region_;
+        uint64_t releaseTimeNs_;
+    };
+
+    void TrimLocked(uint64_t curTimeNs, std::vector<AshmemRegion> &expired);
+    void DumpStatisticsLocked() const;
+    static void Destroy(const std::vector<AshmemRegion> &regions);
+
+    std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<PooledRegion>> freeRegions_; // by the capacity, the latest at the back
+    size_t pooledBytes_ = 0;
+    uint64_t lastTrimTimeNs_ = 0;
+    uint64_t acquireCount_ = 0;
+    uint64_t hitCount_ = 0;
+    uint64_t releaseCount_ = 0;
+    uint64_t dropCount_ = 0;
+};
+}
+}
+#endif
@@ -16,6 +16,7 @@
 #ifndef AVSHAREDMEMORYBASE_H
 #define AVSHAREDMEMORYBASE_H
 
+#include <atomic>
 #include <string>
 #include "nocopyable.h"
 #include "avsharedmemory.h"
@@ -32,10 +33,22 @@ public:
 
     int32_t Init();
     int32_t GetFd() const;
+    // the memory shared to the remote process will not be recycled to the ashmem pool.
+    void MarkShared();
+    bool IsShared() const
+    {
+        return isShared_;
+    }
     std::string GetName() const
     {
         return name_;
     }
+    // identify the local memory across the processes together with the token, 0 for the remote memory.
+    uint64_t GetId() const
+    {
+        return id_;
+    }
+    static uint64_t GetToken();
     uint8_t *GetBase() override;
     int32_t GetSize() override;
     uint32_t GetFlags() override;
@@ -51,6 +64,11 @@ private:
     uint32_t flags_;
     std::string name_;
     int32_t fd_;
+    uint64_t id_ = 0;
+    // the mapped size, larger than the size if the local memory is created at the pooled size class.
+    size_t capacity_ = 0;
+    bool isRemote_ = false;
+    std::atomic<bool> isShared_ = false;
 };
 }
 }
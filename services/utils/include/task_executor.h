@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+class TaskQueue;
+
+/**
+ * Process-wide bounded worker pool that executes the shared TaskQueues. A TaskQueue is dispatched
+ * to the executor when its next task is due, then one of the workers executes the due task. The
+ * TaskQueue guarantees that at most one worker executes its tasks at a time.
+ *
+ * The workers are created on demand when all of them are busy, and exit after idle for a while.
+ */
+class __attribute__((visibility("default"))) TaskExecutor {
+public:
+    static TaskExecutor &Inst();
+
+    void Dispatch(TaskQueue &queue, uint64_t executeTimeNs);
+    // remove the pending dispatches of the queue, and wait for the worker executing it to leave.
+    void Cancel(TaskQueue &queue);
+    void DumpStatistics();
+
+    DISALLOW_COPY_AND_MOVE(TaskExecutor);
+
+private:
+    TaskExecutor();
+    ~TaskExecutor() = default;
+
+    struct DispatchItem {
+        uint64_t executeTimeNs_;
+        uint64_t sequence_;
+        TaskQueue *queue_;
+    };
+    struct DispatchItemCompare {
+        bool operator()(const DispatchItem &lhs, const DispatchItem &rhs) const
+        {
+            if (lhs.executeTimeNs_ != rhs.executeTimeNs_) {
+                return lhs.executeTimeNs_ > rhs.executeTimeNs_;
+            }
+            return lhs.sequence_ > rhs.sequence_;
+        }
+    };
+
+    void WorkerLoop();
+    void SpawnWorkerLocked();
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable leaveCond_;
+    std::vector<DispatchItem> dispatchHeap_; // min-heap ordered by the execute time
+    std::unordered_map<TaskQueue *, uint32_t> runningQueues_;
+    uint64_t sequence_ = 0;
+    uint32_t maxWorkers_ = 0;
+    uint32_t workerCount_ = 0;
+    uint32_t idleWorkerCount_ = 0;
+    uint32_t peakWorkerCount_ = 0;
+    uint64_t dispatchCount_ = 0;
+};
+}
+}
+#endif
@@ -20,7 +20,8 @@
 #include <condition_variable>
 #include <mutex>
 #include <functional>
-#include <list>
+#include <array>
+#include <vector>
 #include <string>
 #include <optional>
 #include <type_traits>
@@ -61,6 +62,19 @@ namespace Media {
  * } else {
  *     MEDIA_LOGI("handler2 not executed");
  * }
+ *
+ * Example 3:
+ * TaskQueue taskQ("your_task_queue_name");
+ * taskQ.Start();
+ * ITaskHandler::Attribute attr;
+ * attr.periodicTimeUs_ = 100000; // executed every 100ms until cancelled
+ * attr.priority_ = ITaskHandler::PRIORITY_LOW;
+ * auto handler3 = std::make_shared<TaskHandler<void>>([]() {
+ *     // your job's detail code;
+ * }, attr);
+ * taskQ.EnqueueTask(handler3);
+ * ...
+ * handler3->Cancel();
  */
 
 class TaskQueue;
@@ -95,9 +109,18 @@ private:
 
 class ITaskHandler {
 public:
+    enum Priority : int32_t {
+        PRIORITY_HIGH = 0, // control tasks, such as seek and stop
+        PRIORITY_NORMAL,
+        PRIORITY_LOW, // bulk tasks, such as filling buffers
+        PRIORITY_BUTT,
+    };
+
     struct Attribute {
         // periodic execute time, UINT64_MAX is not need to execute periodic.
         uint64_t periodicTimeUs_ { UINT64_MAX };
+        // among the tasks due in the same queue, the ones with higher priority are executed first.
+        Priority priority_ { PRIORITY_NORMAL };
     };
     virtual ~ITaskHandler() = default;
     virtual void Execute() = 0;
@@ -213,31 +236,66 @@ private:
     ITaskHandler::Attribute attribute_; // task execute attribute.
 };
 
+/**
+ * By default, a TaskQueue owns a thread to execute its tasks. A shared TaskQueue has no thread,
+ * its tasks are executed by the workers of the process-wide TaskExecutor instead, still one by
+ * one in the same order. The task of a shared TaskQueue must not block forever, such as running
+ * a main loop.
+ */
 class __attribute__((visibility("default"))) TaskQueue {
 public:
-    explicit TaskQueue(const std::string &name) : name_(name) {}
+    explicit TaskQueue(const std::string &name, bool shared = false) : shared_(shared), name_(name) {}
     ~TaskQueue();
 
     int32_t Start();
     int32_t Stop() noexcept;
 
-    // delayUs cannot be gt 10000000ULL.
     int32_t EnqueueTask(const std::shared_ptr<ITaskHandler> &task,
         bool cancelNotExecuted = false, uint64_t delayUs = 0ULL);
 
+    // whether the caller is executing a task of this queue.
+    bool IsInTaskThread() const;
+
     DISALLOW_COPY_AND_MOVE(TaskQueue);
 
 private:
+    friend class TaskExecutor;
+
     struct TaskHandlerItem {
         std::shared_ptr<ITaskHandler> task_ { nullptr };
         uint64_t executeTimeNs_ { 0ULL };
+        uint64_t sequence_ { 0ULL }; // keeps the tasks due at the same time in the enqueue order
+    };
+    struct TaskHandlerItemCompare {
+        bool operator()(const TaskHandlerItem &lhs, const TaskHandlerItem &rhs) const
+        {
+            if (lhs.executeTimeNs_ != rhs.executeTimeNs_) {
+                return lhs.executeTimeNs_ > rhs.executeTimeNs_;
+            }
+            return lhs.sequence_ > rhs.sequence_;
+        }
     };
     void TaskProcessor();
+    void RunOnExecutor();
+    void ExecuteTask(TaskHandlerItem &item);
+    void DispatchLocked(uint64_t executeTimeNs);
+    void DumpStatistics();
     void CancelNotExecutedTaskLocked();
+    void PushTaskLocked(const std::shared_ptr<ITaskHandler> &task, uint64_t executeTimeNs);
+    bool PopDueTaskLocked(uint64_t curTimeNs, TaskHandlerItem &item, uint64_t &nextTimeNs);
+    bool HasTaskLocked() const;
 
     bool isExit_ = true;
     std::unique_ptr<std::thread> thread_;
-    std::list<TaskHandlerItem> taskList_;
+    // one min-heap ordered by the execute time for each priority.
+    std::array<std::vector<TaskHandlerItem>, ITaskHandler::PRIORITY_BUTT> taskHeaps_;
+    uint64_t sequence_ = 0;
+    bool shared_ = false;
+    bool running_ = false; // the shared queue is executing a task on an executor worker
+    uint64_t dispatchTimeNs_ = UINT64_MAX; // the earliest time the shared queue is dispatched at
+    uint64_t executedCount_ = 0;
+    uint64_t totalExecuteTimeUs_ = 0;
+    uint64_t maxDelayUs_ = 0; // the max delay between the task due and its execution
     std::mutex mutex_;
     std::condition_variable cond_;
     std::string name_;
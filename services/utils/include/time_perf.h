@@ -16,8 +16,10 @@
 #ifndef TIME_PERF_H
 #define TIME_PERF_H
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <string_view>
-#include <sys/time.h>
 #include <unordered_map>
 #include <mutex>
 #include "nocopyable.h"
@@ -37,6 +39,11 @@ namespace Media {
     TimePerf::Inst().DumpObjectRecord(reinterpret_cast<uintptr_t>(obj)); \
     TimePerf::Inst().CleanObjectRecord(reinterpret_cast<uintptr_t>(obj))
 
+/**
+ * The start and stop of the records are lock-free once the record of the obj and tag has been
+ * looked up by the calling thread, so that it is cheap enough for the per-frame probes. Every
+ * record keeps a fixed-bucket latency histogram, the percentiles are computed when dumping.
+ */
 class __attribute__((visibility("default"))) TimePerf {
 public:
     static TimePerf &Inst()
@@ -56,20 +63,54 @@ private:
     TimePerf() = default;
     ~TimePerf() = default;
 
-    void TimeVal2USec(const struct timeval &time, int64_t &usec);
+    // linear buckets for the first microseconds, then 4 buckets for each power of 2.
+    static constexpr int32_t LINEAR_BUCKET_COUNT = 16;
+    static constexpr int32_t SUB_BUCKET_BITS = 2;
+    static constexpr int32_t HISTOGRAM_BUCKET_COUNT = 128;
 
     struct PerfRecord {
-        int64_t currStart; // microsecond
-        int64_t currStop;  // microsecond
-        int64_t peakTime;
-        int64_t firstTime;
-        int64_t avgTime;
-        int64_t count;
+        std::atomic<int64_t> currStart; // microsecond
+        std::atomic<int64_t> peakTime;
+        std::atomic<int64_t> firstTime;
+        std::atomic<int64_t> totalTime;
+        std::atomic<int64_t> count;
+        std::array<std::atomic<uint32_t>, HISTOGRAM_BUCKET_COUNT> histogram;
+    };
+
+    struct RecordKey {
+        uintptr_t obj;
+        std::string_view tag;
+        bool operator==(const RecordKey &other) const
+        {
+            return obj == other.obj && tag == other.tag;
+        }
+    };
+
+    struct RecordKeyHash {
+        size_t operator()(const RecordKey &key) const
+        {
+            return std::hash<uintptr_t>()(key.obj) ^ (std::hash<std::string_view>()(key.tag) << 1);
+        }
+    };
+
+    // the records looked up by the current thread, dropped once any record is cleaned.
+    struct ThreadRecordCache {
+        uint32_t generation = 0;
+        std::unordered_map<RecordKey, std::shared_ptr<PerfRecord>, RecordKeyHash> records;
     };
 
-    using TagRecords = std::unordered_map<std::string_view, PerfRecord>;
+    std::shared_ptr<PerfRecord> GetRecord(uintptr_t obj, std::string_view tag, bool create);
+    std::shared_ptr<PerfRecord> GetRecordLocked(uintptr_t obj, std::string_view tag, bool create);
+    void DumpRecord(uintptr_t obj, std::string_view tag, const PerfRecord &record);
+    static int64_t GetPercentile(const PerfRecord &record, int64_t count, int32_t permille);
+    static int32_t GetBucketIndex(int64_t value);
+    static int64_t GetBucketUpperBound(int32_t index);
+    static int64_t GetCurrentTimeUs();
+
+    using TagRecords = std::unordered_map<std::string_view, std::shared_ptr<PerfRecord>>;
     std::unordered_map<uintptr_t, TagRecords> objPerfRecords_;
     std::mutex mutex_;
+    std::atomic<uint32_t> generation_ = 1;
 };
 
 struct __attribute__((visibility("default"))) AutoPerf {
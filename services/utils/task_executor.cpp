@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "task_executor.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <pthread.h>
+#include "task_queue.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "TaskExecutor"};
+    constexpr uint32_t MIN_WORKERS = 2;
+    constexpr uint32_t MAX_WORKERS = 16;
+    constexpr uint32_t WORKERS_PER_CORE = 2;
+    constexpr std::chrono::seconds WORKER_IDLE_TIMEOUT(30);
+
+    uint64_t GetCurrentTimeNs()
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+}
+
+namespace OHOS {
+namespace Media {
+TaskExecutor &TaskExecutor::Inst()
+{
+    // never destroyed, the detached workers may be still running at the process exit.
+    static TaskExecutor *inst = new TaskExecutor();
+    return *inst;
+}
+
+TaskExecutor::TaskExecutor()
+{
+    uint32_t cores = std::thread::hardware_concurrency();
+    maxWorkers_ = std::clamp(cores * WORKERS_PER_CORE, MIN_WORKERS, MAX_WORKERS);
+    MEDIA_LOGI("max workers: %{public}u", maxWorkers_);
+}
+
+void TaskExecutor::Dispatch(TaskQueue &queue, uint64_t executeTimeNs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    dispatchHeap_.push_back({executeTimeNs, sequence_++, &queue});
+    std::push_heap(dispatchHeap_.begin(), dispatchHeap_.end(), DispatchItemCompare());
+    dispatchCount_++;
+
+    if (idleWorkerCount_ == 0 && workerCount_ < maxWorkers_) {
+        SpawnWorkerLocked();
+    }
+    cond_.notify_one();
+}
+
+void TaskExecutor::Cancel(TaskQueue &queue)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = std::remove_if(dispatchHeap_.begin(), dispatchHeap_.end(),
+        [&queue](const DispatchItem &item) { return item.queue_ == &queue; });
+    if (iter != dispatchHeap_.end()) {
+        dispatchHeap_.erase(iter, dispatchHeap_.end());
+        std::make_heap(dispatchHeap_.begin(), dispatchHeap_.end(), DispatchItemCompare());
+    }
+
+    leaveCond_.wait(lock, [this, &queue]() { return runningQueues_.count(&queue) == 0; });
+}
+
+void TaskExecutor::SpawnWorkerLocked()
+{
+    workerCount_++;
+    peakWorkerCount_ = std::max(peakWorkerCount_, workerCount_);
+    std::thread worker(&TaskExecutor::WorkerLoop, this);
+    worker.detach();
+}
+
+void TaskExecutor::WorkerLoop()
+{
+    (void)pthread_setname_np(pthread_self(), "TaskExecutor");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        if (dispatchHeap_.empty()) {
+            idleWorkerCount_++;
+            bool hasItem = cond_.wait_for(lock, WORKER_IDLE_TIMEOUT, [this]() { return !dispatchHeap_.empty(); });
+            idleWorkerCount_--;
+            if (!hasItem && workerCount_ > MIN_WORKERS) {
+                workerCount_--;
+                return;
+            }
+            continue;
+        }
+
+        uint64_t curTimeNs = GetCurrentTimeNs();
+        DispatchItem item = dispatchHeap_.front();
+        if (item.executeTimeNs_ > curTimeNs) {
+            idleWorkerCount_++;
+            (void)cond_.wait_for(lock, std::chrono::nanoseconds(item.executeTimeNs_ - curTimeNs));
+            idleWorkerCount_--;
+            continue;
+        }
+
+        std::pop_heap(dispatchHeap_.begin(), dispatchHeap_.end(), DispatchItemCompare());
+        dispatchHeap_.pop_back();
+        runningQueues_[item.queue_]++;
+        lock.unlock();
+
+        item.queue_->RunOnExecutor();
+
+        lock.lock();
+        auto iter = runningQueues_.find(item.queue_);
+        if (iter != runningQueues_.end() && --iter->second == 0) {
+            runningQueues_.erase(iter);
+        }
+        leaveCond_.notify_all();
+    }
+}
+
+void TaskExecutor::DumpStatistics()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    MEDIA_LOGI("workers: %{public}u, idle: %{public}u, peak: %{public}u, max: %{public}u, "
+               "pending dispatch: %{public}zu, total dispatch: %{public}" PRIu64 "",
+               workerCount_, idleWorkerCount_, peakWorkerCount_, maxWorkers_,
+               dispatchHeap_.size(), dispatchCount_);
+}
+}
+}
@@ -14,11 +14,23 @@
  */
 
 #include "task_queue.h"
+#include <algorithm>
+#include "task_executor.h"
 #include "media_log.h"
 #include "media_errors.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "TaskQueue"};
+    constexpr uint64_t US_TO_NS = 1000;
+
+    uint64_t GetCurrentTimeNs()
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+
+    // the queue whose task is being executed by the current thread.
+    thread_local const OHOS::Media::TaskQueue *g_currentQueue = nullptr;
 }
 
 namespace OHOS {
@@ -31,12 +43,14 @@ TaskQueue::~TaskQueue()
 int32_t TaskQueue::Start()
 {
     std::unique_lock<std::mutex> lock(mutex_);
-    if (thread_ != nullptr) {
+    if (thread_ != nullptr || (shared_ && !isExit_)) {
         MEDIA_LOGW("Started already, ignore ! [%{public}s]", name_.c_str());
         return MSERR_OK;
     }
     isExit_ = false;
-    thread_ = std::make_unique<std::thread>(&TaskQueue::TaskProcessor, this);
+    if (!shared_) {
+        thread_ = std::make_unique<std::thread>(&TaskQueue::TaskProcessor, this);
+    }
 
     return MSERR_OK;
 }
@@ -49,11 +63,22 @@ int32_t TaskQueue::Stop() noexcept
         return MSERR_OK;
     }
 
-    if (std::this_thread::get_id() == thread_->get_id()) {
+    if (IsInTaskThread()) {
         MEDIA_LOGI("Stop at the task thread, reject");
         return MSERR_INVALID_OPERATION;
     }
 
+    if (shared_) {
+        isExit_ = true;
+        lock.unlock();
+        TaskExecutor::Inst().Cancel(*this);
+        lock.lock();
+        dispatchTimeNs_ = UINT64_MAX;
+        CancelNotExecutedTaskLocked();
+        DumpStatistics();
+        return MSERR_OK;
+    }
+
     std::unique_ptr<std::thread> t;
     isExit_ = true;
     cond_.notify_all();
@@ -66,23 +91,26 @@ int32_t TaskQueue::Stop() noexcept
 
     lock.lock();
     CancelNotExecutedTaskLocked();
+    DumpStatistics();
     return MSERR_OK;
 }
 
+bool TaskQueue::IsInTaskThread() const
+{
+    return g_currentQueue == this;
+}
+
 // cancelNotExecuted = false, delayUs = 0ULL.
 int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool cancelNotExecuted, uint64_t delayUs)
 {
-    constexpr uint64_t MAX_DELAY_US = 10000000ULL; // max delay.
-
     CHECK_AND_RETURN_RET_LOG(task != nullptr, MSERR_INVALID_VAL,
         "Enqueue task when taskqueue task is nullptr.[%{public}s]", name_.c_str());
 
     task->Clear();
 
-    CHECK_AND_RETURN_RET_LOG(delayUs < MAX_DELAY_US, MSERR_INVALID_VAL,
-        "Enqueue task when taskqueue delayUs[%{public}" PRIu64 "] is >= max delayUs[ %{public}" PRIu64
-        "], invalid! [%{public}s]",
-        delayUs, MAX_DELAY_US, name_.c_str());
+    CHECK_AND_RETURN_RET_LOG(delayUs < UINT64_MAX / US_TO_NS, MSERR_INVALID_VAL,
+        "Enqueue task when taskqueue delayUs[%{public}" PRIu64 "] is too large, invalid! [%{public}s]",
+        delayUs, name_.c_str());
 
     std::unique_lock<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(!isExit_, MSERR_INVALID_OPERATION,
@@ -92,70 +120,193 @@ int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool c
         CancelNotExecutedTaskLocked();
     }
 
-    // 1000 is ns to us.
-    constexpr uint32_t US_TO_NS = 1000;
-    uint64_t curTimeNs = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    uint64_t curTimeNs = GetCurrentTimeNs();
     CHECK_AND_RETURN_RET_LOG(curTimeNs < UINT64_MAX - delayUs * US_TO_NS, MSERR_INVALID_OPERATION,
         "Enqueue task but timestamp is overflow, why? [%{public}s]", name_.c_str());
 
     uint64_t executeTimeNs = delayUs * US_TO_NS + curTimeNs;
-    auto iter = std::find_if(taskList_.begin(), taskList_.end(), [executeTimeNs](const TaskHandlerItem &item) {
-        return (item.executeTimeNs_ > executeTimeNs);
-    });
-    (void)taskList_.insert(iter, {task, executeTimeNs});
-    cond_.notify_all();
+    PushTaskLocked(task, executeTimeNs);
+    if (!shared_) {
+        cond_.notify_all();
+    } else if (!running_) {
+        DispatchLocked(executeTimeNs); // otherwise the running worker dispatches it again when finished
+    }
 
     return 0;
 }
 
+void TaskQueue::PushTaskLocked(const std::shared_ptr<ITaskHandler> &task, uint64_t executeTimeNs)
+{
+    int32_t priority = task->GetAttribute().priority_;
+    if (priority < ITaskHandler::PRIORITY_HIGH || priority >= ITaskHandler::PRIORITY_BUTT) {
+        priority = ITaskHandler::PRIORITY_NORMAL;
+    }
+
+    auto &heap = taskHeaps_[priority];
+    heap.push_back({task, executeTimeNs, sequence_++});
+    std::push_heap(heap.begin(), heap.end(), TaskHandlerItemCompare());
+}
+
+bool TaskQueue::PopDueTaskLocked(uint64_t curTimeNs, TaskHandlerItem &item, uint64_t &nextTimeNs)
+{
+    nextTimeNs = UINT64_MAX;
+    for (auto &heap : taskHeaps_) {
+        if (heap.empty()) {
+            continue;
+        }
+        if (heap.front().executeTimeNs_ <= curTimeNs) {
+            std::pop_heap(heap.begin(), heap.end(), TaskHandlerItemCompare());
+            item = heap.back();
+            heap.pop_back();
+            return true;
+        }
+        nextTimeNs = std::min(nextTimeNs, heap.front().executeTimeNs_);
+    }
+    return false;
+}
+
+bool TaskQueue::HasTaskLocked() const
+{
+    return std::any_of(taskHeaps_.begin(), taskHeaps_.end(), [](const auto &heap) { return !heap.empty(); });
+}
+
 void TaskQueue::CancelNotExecutedTaskLocked()
 {
     MEDIA_LOGI("All task not executed are being cancelled..........[%{public}s]", name_.c_str());
-    while (!taskList_.empty()) {
-        std::shared_ptr<ITaskHandler> task = taskList_.front().task_;
-        taskList_.pop_front();
-        if (task != nullptr) {
-            task->Cancel();
+    for (auto &heap : taskHeaps_) {
+        for (auto &item : heap) {
+            if (item.task_ != nullptr) {
+                item.task_->Cancel();
+            }
         }
+        heap.clear();
     }
 }
 
 void TaskQueue::TaskProcessor()
 {
     MEDIA_LOGI("Enter TaskProcessor [%{public}s]", name_.c_str());
+    g_currentQueue = this;
     while (true) {
         std::unique_lock<std::mutex> lock(mutex_);
-        cond_.wait(lock, [this] { return isExit_ || !taskList_.empty(); });
+        cond_.wait(lock, [this] { return isExit_ || HasTaskLocked(); });
         if (isExit_) {
             MEDIA_LOGI("Exit TaskProcessor [%{public}s]", name_.c_str());
             return;
         }
-        TaskHandlerItem item = taskList_.front();
-        uint64_t curTimeNs = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
-        if (curTimeNs >= item.executeTimeNs_) {
-            taskList_.pop_front();
-        } else {
-            uint64_t diff =  item.executeTimeNs_ - curTimeNs;
-            (void)cond_.wait_for(lock, std::chrono::nanoseconds(diff));
+        TaskHandlerItem item;
+        uint64_t nextTimeNs = UINT64_MAX;
+        uint64_t curTimeNs = GetCurrentTimeNs();
+        if (!PopDueTaskLocked(curTimeNs, item, nextTimeNs)) {
+            (void)cond_.wait_for(lock, std::chrono::nanoseconds(nextTimeNs - curTimeNs));
             continue;
         }
         lock.unlock();
 
-        if (item.task_ == nullptr || item.task_->IsCanceled()) {
-            MEDIA_LOGD("task is nullptr or task canceled. [%{public}s]", name_.c_str());
-            continue;
-        }
+        ExecuteTask(item);
+    }
+    MEDIA_LOGI("Leave TaskProcessor [%{public}s]", name_.c_str());
+}
 
-        item.task_->Execute();
-        if (item.task_->GetAttribute().periodicTimeUs_ == UINT64_MAX) {
-            continue;
+void TaskQueue::RunOnExecutor()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (isExit_ || running_) {
+        return; // stale dispatch, the running worker dispatches the queue again when finished
+    }
+    dispatchTimeNs_ = UINT64_MAX;
+
+    TaskHandlerItem item;
+    uint64_t nextTimeNs = UINT64_MAX;
+    if (!PopDueTaskLocked(GetCurrentTimeNs(), item, nextTimeNs)) {
+        if (nextTimeNs != UINT64_MAX) {
+            DispatchLocked(nextTimeNs);
         }
-        int32_t res = EnqueueTask(item.task_, false, item.task_->GetAttribute().periodicTimeUs_);
-        if (res != MSERR_OK) {
-            MEDIA_LOGW("enqueue periodic task failed:%d, why? [%{public}s]", res, name_.c_str());
+        return;
+    }
+
+    running_ = true;
+    lock.unlock();
+
+    const TaskQueue *lastQueue = g_currentQueue;
+    g_currentQueue = this;
+    ExecuteTask(item);
+    g_currentQueue = lastQueue;
+
+    lock.lock();
+    running_ = false;
+    if (isExit_) {
+        return;
+    }
+
+    // yield the worker after each task, so that the busy queue does not starve the others.
+    uint64_t earliestTimeNs = UINT64_MAX;
+    for (auto &heap : taskHeaps_) {
+        if (!heap.empty()) {
+            earliestTimeNs = std::min(earliestTimeNs, heap.front().executeTimeNs_);
         }
     }
-    MEDIA_LOGI("Leave TaskProcessor [%{public}s]", name_.c_str());
+    if (earliestTimeNs != UINT64_MAX) {
+        DispatchLocked(earliestTimeNs);
+    }
+}
+
+void TaskQueue::DispatchLocked(uint64_t executeTimeNs)
+{
+    if (executeTimeNs >= dispatchTimeNs_) {
+        return; // will be executed by the earlier dispatch
+    }
+    dispatchTimeNs_ = executeTimeNs;
+    TaskExecutor::Inst().Dispatch(*this, executeTimeNs);
+}
+
+void TaskQueue::ExecuteTask(TaskHandlerItem &item)
+{
+    if (item.task_ == nullptr || item.task_->IsCanceled()) {
+        MEDIA_LOGD("task is nullptr or task canceled. [%{public}s]", name_.c_str());
+        return;
+    }
+
+    uint64_t startTimeNs = GetCurrentTimeNs();
+    item.task_->Execute();
+    uint64_t finishTimeNs = GetCurrentTimeNs();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    executedCount_++;
+    totalExecuteTimeUs_ += (finishTimeNs - startTimeNs) / US_TO_NS;
+    if (startTimeNs > item.executeTimeNs_) {
+        maxDelayUs_ = std::max(maxDelayUs_, (startTimeNs - item.executeTimeNs_) / US_TO_NS);
+    }
+
+    uint64_t periodicTimeUs = item.task_->GetAttribute().periodicTimeUs_;
+    if (periodicTimeUs == UINT64_MAX || periodicTimeUs >= UINT64_MAX / US_TO_NS) {
+        return;
+    }
+
+    lock.unlock();
+    item.task_->Clear();
+    lock.lock();
+    if (isExit_ || item.task_->IsCanceled()) {
+        return;
+    }
+    // schedule from the planned time rather than the finished time to avoid drift, but never
+    // queue up the missed periods if the task falls behind.
+    uint64_t periodicTimeNs = periodicTimeUs * US_TO_NS;
+    uint64_t executeTimeNs = item.executeTimeNs_ + periodicTimeNs;
+    if (executeTimeNs < item.executeTimeNs_ || executeTimeNs < finishTimeNs) {
+        executeTimeNs = finishTimeNs;
+    }
+    PushTaskLocked(item.task_, executeTimeNs);
+}
+
+void TaskQueue::DumpStatistics()
+{
+    if (executedCount_ == 0) {
+        return;
+    }
+    MEDIA_LOGI("[%{public}s] shared: %{public}d, executed: %{public}" PRIu64 ", avg execute time: %{public}" PRIu64
+               "us, max delay: %{public}" PRIu64 "us", name_.c_str(), shared_, executedCount_,
+               totalExecuteTimeUs_ / executedCount_, maxDelayUs_);
 }
 }
 }
@@ -14,114 +14,127 @@
  */
 
 #include "time_perf.h"
-#include <climits>
+#include <algorithm>
+#include <ctime>
 #include "media_log.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaTimePerf"};
-    static const int MICRO_SEC_PER_SEC = 1000000;
-    static const int64_t MAX_SEC = LLONG_MAX / MICRO_SEC_PER_SEC;
-    static const int INVALID_TIME = -1;
+    static const int64_t MICRO_SEC_PER_SEC = 1000000;
+    static const int64_t NANO_SEC_PER_MICRO_SEC = 1000;
+    static const int64_t INVALID_TIME = -1;
+    static const int32_t PERMILLE_P50 = 500;
+    static const int32_t PERMILLE_P95 = 950;
+    static const int32_t PERMILLE_P99 = 990;
+    static const int32_t PERMILLE_MAX = 1000;
 }
 
 namespace OHOS {
 namespace Media {
 void TimePerf::StartPerfRecord(uintptr_t obj, std::string_view tag)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto objIter = objPerfRecords_.find(obj);
-    if (objIter == objPerfRecords_.end()) {
-        auto ret = objPerfRecords_.emplace(obj, TagRecords{});
-        objIter = ret.first;
+    auto record = GetRecord(obj, tag, true);
+    if (record == nullptr) {
+        return;
     }
 
-    auto &tagRecords = objIter->second;
-    auto tagIter = tagRecords.find(tag);
-    if (tagIter == tagRecords.end()) {
-        auto ret = tagRecords.emplace(tag, PerfRecord {INVALID_TIME});
-        tagIter = ret.first;
-        tagIter->second.currStart = INVALID_TIME;
-        tagIter->second.currStop = INVALID_TIME;
-        tagIter->second.firstTime = INVALID_TIME;
-        tagIter->second.peakTime = INVALID_TIME;
-        tagIter->second.avgTime = INVALID_TIME;
-        tagIter->second.count = 0;
-    }
-
-    auto &record = tagIter->second;
-    if (record.currStart != INVALID_TIME) {
+    int64_t expected = INVALID_TIME;
+    if (!record->currStart.compare_exchange_strong(expected, GetCurrentTimeUs(), std::memory_order_relaxed)) {
         MEDIA_LOGW("already start for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
                    FAKE_POINTER(obj), tag.data());
-        return;
-    }
-
-    struct timeval start {};
-    int ret = gettimeofday(&start, nullptr);
-    if (ret != 0) {
-        MEDIA_LOGW("get time of day failed");
-        return;
     }
-    TimeVal2USec(start, record.currStart);
 }
 
 void TimePerf::StopPerfRecord(uintptr_t obj, std::string_view tag)
 {
-    struct timeval stop {};
-    int getTimeRet = gettimeofday(&stop, nullptr);
-    if (getTimeRet != 0) {
-        MEDIA_LOGW("get time of day failed");
-    }
-
-    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t stop = GetCurrentTimeUs();
 
-    auto objIter = objPerfRecords_.find(obj);
-    if (objIter == objPerfRecords_.end()) {
+    auto record = GetRecord(obj, tag, false);
+    if (record == nullptr) {
         MEDIA_LOGW("no record exits for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
                    FAKE_POINTER(obj), tag.data());
         return;
     }
 
-    auto &tagRecords = objIter->second;
-    auto tagIter = tagRecords.find(tag);
-    if (tagIter == tagRecords.end()) {
-        MEDIA_LOGW("no record exits for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
+    int64_t start = record->currStart.exchange(INVALID_TIME, std::memory_order_relaxed);
+    if (start == INVALID_TIME) {
+        MEDIA_LOGW("not start record for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
                    FAKE_POINTER(obj), tag.data());
         return;
     }
 
-    auto &record = tagIter->second;
-    if (record.currStart == INVALID_TIME) {
-        MEDIA_LOGW("not start record for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
-                   FAKE_POINTER(obj), tag.data());
-        return;
+    int64_t currTime = stop > start ? stop - start : 0;
+    int64_t expected = INVALID_TIME;
+    (void)record->firstTime.compare_exchange_strong(expected, currTime, std::memory_order_relaxed);
+
+    int64_t peakTime = record->peakTime.load(std::memory_order_relaxed);
+    while (currTime > peakTime &&
+        !record->peakTime.compare_exchange_weak(peakTime, currTime, std::memory_order_relaxed)) {
     }
 
-    if (getTimeRet != 0) {
-        record.currStart = INVALID_TIME;
-        return;
+    record->histogram[GetBucketIndex(currTime)].fetch_add(1, std::memory_order_relaxed);
+    record->totalTime.fetch_add(currTime, std::memory_order_relaxed);
+    record->count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<TimePerf::PerfRecord> TimePerf::GetRecord(uintptr_t obj, std::string_view tag, bool create)
+{
+    static thread_local ThreadRecordCache cache;
+
+    uint32_t generation = generation_.load(std::memory_order_acquire);
+    if (cache.generation != generation) {
+        cache.records.clear();
+        cache.generation = generation;
+    }
+
+    RecordKey key = { obj, tag };
+    auto iter = cache.records.find(key);
+    if (iter != cache.records.end()) {
+        return iter->second;
     }
 
-    TimeVal2USec(stop, record.currStop);
-    int64_t currTime = record.currStop - record.currStart;
-    if (currTime > record.peakTime || record.peakTime == INVALID_TIME) {
-        record.peakTime = currTime;
+    std::shared_ptr<PerfRecord> record = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        record = GetRecordLocked(obj, tag, create);
     }
-    if (record.firstTime == INVALID_TIME) {
-        record.firstTime = currTime;
+    if (record != nullptr) {
+        cache.records.emplace(key, record);
     }
+    return record;
+}
 
-    record.avgTime = (record.avgTime * record.count + currTime) / (record.count + 1);
-    record.count += 1;
-    record.currStart = INVALID_TIME;
-    record.currStop = INVALID_TIME;
+std::shared_ptr<TimePerf::PerfRecord> TimePerf::GetRecordLocked(uintptr_t obj, std::string_view tag, bool create)
+{
+    auto objIter = objPerfRecords_.find(obj);
+    if (objIter == objPerfRecords_.end()) {
+        if (!create) {
+            return nullptr;
+        }
+        auto ret = objPerfRecords_.emplace(obj, TagRecords{});
+        objIter = ret.first;
+    }
 
-    MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s] "
-               "current take time: %{public}" PRIi64 "us, first time: %{public}" PRIi64 ", "
-               "peak time: %{public}" PRIi64 ", avg time: %{public}" PRIi64 ", "
-               "count: %{public}" PRIi64 "",
-               FAKE_POINTER(obj), tag.data(), currTime, record.firstTime,
-               record.peakTime, record.avgTime, record.count);
+    auto &tagRecords = objIter->second;
+    auto tagIter = tagRecords.find(tag);
+    if (tagIter != tagRecords.end()) {
+        return tagIter->second;
+    }
+    if (!create) {
+        return nullptr;
+    }
+
+    auto record = std::make_shared<PerfRecord>();
+    record->currStart = INVALID_TIME;
+    record->peakTime = INVALID_TIME;
+    record->firstTime = INVALID_TIME;
+    record->totalTime = 0;
+    record->count = 0;
+    for (auto &bucket : record->histogram) {
+        bucket = 0;
+    }
+    (void)tagRecords.emplace(tag, record);
+    return record;
 }
 
 void TimePerf::DumpObjectRecord(uintptr_t obj)
@@ -135,14 +148,7 @@ void TimePerf::DumpObjectRecord(uintptr_t obj)
     }
 
     for (auto &[tag, record] : objIter->second) {
-        if (record.count == 0) {
-            continue;
-        }
-        MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s] "
-                   ", first time: %{public}" PRIi64 ", peak time: %{public}" PRIi64 ", "
-                   "avg time: %{public}" PRIi64 ", count: %{public}" PRIi64 "",
-                   FAKE_POINTER(obj), tag.data(), record.firstTime,
-                   record.peakTime, record.avgTime, record.count);
+        DumpRecord(obj, tag, *record);
     }
 }
 
@@ -155,6 +161,8 @@ void TimePerf::CleanObjectRecord(uintptr_t obj)
         return;
     }
     (void)objPerfRecords_.erase(objIter);
+    // the address may be reused by another object, invalidate the records cached by the threads.
+    generation_.fetch_add(1, std::memory_order_release);
 }
 
 void TimePerf::DumpAllRecord()
@@ -163,13 +171,7 @@ void TimePerf::DumpAllRecord()
 
     for (auto &[obj, tagRecords] : objPerfRecords_) {
         for (auto &[tag, record] : tagRecords) {
-            if (record.count == 0) {
-                continue;
-            }
-            MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s], first time: %{public}" PRIi64 ""
-                ", peak time: %{public}" PRIi64 ", avg time: %{public}" PRIi64 ", count: %{public}" PRIi64 "",
-                FAKE_POINTER(obj), tag.data(), record.firstTime,
-                record.peakTime, record.avgTime, record.count);
+            DumpRecord(obj, tag, *record);
         }
     }
 }
@@ -178,19 +180,76 @@ void TimePerf::CleanAllRecord()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     objPerfRecords_.clear();
+    generation_.fetch_add(1, std::memory_order_release);
 }
 
-void TimePerf::TimeVal2USec(const struct timeval &time, int64_t &usec)
+void TimePerf::DumpRecord(uintptr_t obj, std::string_view tag, const PerfRecord &record)
 {
-    if ((static_cast<int64_t>(time.tv_sec) > MAX_SEC) ||
-        (static_cast<int64_t>(time.tv_sec) == MAX_SEC && time.tv_usec > 0) ||
-        (time.tv_usec > MICRO_SEC_PER_SEC)) {
-        MEDIA_LOGW("time overflow, sec: %{public}ld, usec: %{public}ld", time.tv_sec, time.tv_usec);
-        usec = 0;
+    // the samples may be still recording, count them from the histogram to keep consistent.
+    int64_t count = 0;
+    for (auto &bucket : record.histogram) {
+        count += bucket.load(std::memory_order_relaxed);
+    }
+    if (count == 0) {
         return;
     }
 
-    usec = static_cast<int64_t>(time.tv_sec) * MICRO_SEC_PER_SEC + time.tv_usec;
+    int64_t avgTime = record.totalTime.load(std::memory_order_relaxed) /
+        std::max<int64_t>(record.count.load(std::memory_order_relaxed), 1);
+    MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s], first time: %{public}" PRIi64 ""
+        ", peak time: %{public}" PRIi64 ", avg time: %{public}" PRIi64 ", count: %{public}" PRIi64 ""
+        ", p50: %{public}" PRIi64 ", p95: %{public}" PRIi64 ", p99: %{public}" PRIi64 "",
+        FAKE_POINTER(obj), tag.data(), record.firstTime.load(std::memory_order_relaxed),
+        record.peakTime.load(std::memory_order_relaxed), avgTime, count,
+        GetPercentile(record, count, PERMILLE_P50), GetPercentile(record, count, PERMILLE_P95),
+        GetPercentile(record, count, PERMILLE_P99));
+}
+
+int64_t TimePerf::GetPercentile(const PerfRecord &record, int64_t count, int32_t permille)
+{
+    int64_t target = std::max<int64_t>((count * permille + PERMILLE_MAX - 1) / PERMILLE_MAX, 1);
+    int64_t peakTime = record.peakTime.load(std::memory_order_relaxed);
+
+    int64_t accumulated = 0;
+    for (int32_t index = 0; index < HISTOGRAM_BUCKET_COUNT; index++) {
+        accumulated += record.histogram[index].load(std::memory_order_relaxed);
+        if (accumulated >= target) {
+            return std::min(GetBucketUpperBound(index), peakTime);
+        }
+    }
+    return peakTime;
+}
+
+int32_t TimePerf::GetBucketIndex(int64_t value)
+{
+    if (value < LINEAR_BUCKET_COUNT) {
+        return value < 0 ? 0 : static_cast<int32_t>(value);
+    }
+
+    // LINEAR_BUCKET_COUNT is 2^(SUB_BUCKET_BITS + 2), the msb of value is at least 4.
+    int32_t msb = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+    int32_t subIndex = static_cast<int32_t>(value >> (msb - SUB_BUCKET_BITS)) & ((1 << SUB_BUCKET_BITS) - 1);
+    int32_t index = LINEAR_BUCKET_COUNT + ((msb - SUB_BUCKET_BITS - 2) << SUB_BUCKET_BITS) + subIndex;
+    return std::min(index, HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+int64_t TimePerf::GetBucketUpperBound(int32_t index)
+{
+    if (index < LINEAR_BUCKET_COUNT) {
+        return index;
+    }
+
+    int32_t msb = ((index - LINEAR_BUCKET_COUNT) >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS + 2;
+    int64_t subIndex = (index - LINEAR_BUCKET_COUNT) & ((1 << SUB_BUCKET_BITS) - 1);
+    int64_t lowerBound = ((1LL << SUB_BUCKET_BITS) + subIndex) << (msb - SUB_BUCKET_BITS);
+    return lowerBound + (1LL << (msb - SUB_BUCKET_BITS)) - 1;
+}
+
+int64_t TimePerf::GetCurrentTimeUs()
+{
+    struct timespec time {};
+    (void)clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<int64_t>(time.tv_sec) * MICRO_SEC_PER_SEC + time.tv_nsec / NANO_SEC_PER_MICRO_SEC;
 }
 }
 }
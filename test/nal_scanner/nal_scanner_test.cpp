@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Checks NalScanner against the byte loop it replaced, and measures both. Build it once as is, which
+ * takes the SSE2 or NEON path of the target, and once with NAL_SCANNER_NO_SIMD for the word path.
+ * Returns non-zero on any mismatch.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "nal_scanner.h"
+
+using namespace OHOS::Media;
+
+namespace {
+    constexpr uint32_t RANDOM_BUFFERS = 200000;
+    constexpr size_t MAX_RANDOM_BUFFER_SIZE = 256;
+    constexpr size_t MAX_MISALIGN = 16;
+    constexpr size_t STREAM_SIZE = 8 * 1024 * 1024;
+    constexpr size_t MAX_NAL_PAYLOAD = 64 * 1024;
+    constexpr uint32_t BENCH_PASSES = 20;
+    constexpr uint32_t SEED = 20211;
+    constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+    // the loop used by VideoCaptureSfEsAvcImpl before NalScanner, without its read past the end.
+    const uint8_t *FindStartCodeByBytes(const uint8_t *start, const uint8_t *end, uint32_t &startCodeSize)
+    {
+        while (end - start >= 3) {
+            if (start[0] == 0x00 && start[1] == 0x00 && start[2] == 0x01) {
+                startCodeSize = 3; // 0x000001
+                return start;
+            }
+            if (end - start >= 4 && start[0] == 0x00 && start[1] == 0x00 && start[2] == 0x00 && start[3] == 0x01) {
+                startCodeSize = 4; // 0x00000001
+                return start;
+            }
+            start++;
+        }
+        return end;
+    }
+
+    using FindFunc = const uint8_t *(*)(const uint8_t *, const uint8_t *, uint32_t &);
+
+    struct StartCode {
+        size_t offset;
+        uint32_t size;
+        bool operator==(const StartCode &other) const
+        {
+            return offset == other.offset && size == other.size;
+        }
+    };
+
+    std::vector<StartCode> ScanAll(FindFunc find, const uint8_t *begin, const uint8_t *end)
+    {
+        std::vector<StartCode> codes;
+        const uint8_t *cur = begin;
+        while (cur < end) {
+            uint32_t size = 0;
+            const uint8_t *pos = find(cur, end, size);
+            if (pos == end) {
+                break;
+            }
+            codes.push_back({ static_cast<size_t>(pos - begin), size });
+            cur = pos + size;
+        }
+        return codes;
+    }
+
+    const char *GetBlockPath()
+    {
+#if defined(NAL_SCANNER_NO_SIMD)
+        return "scalar";
+#elif defined(__SSE2__)
+        return "SSE2";
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+
+    // small buffers dense with zeros and ones, scanned from every misalignment.
+    bool CheckRandomBuffers(std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<size_t> sizeDist(0, MAX_RANDOM_BUFFER_SIZE);
+        std::uniform_int_distribution<uint32_t> byteDist(0, 7);
+        std::vector<uint8_t> storage(MAX_RANDOM_BUFFER_SIZE + MAX_MISALIGN);
+        for (uint32_t i = 0; i < RANDOM_BUFFERS; i++) {
+            size_t misalign = i % MAX_MISALIGN;
+            size_t size = sizeDist(rng);
+            uint8_t *data = storage.data() + misalign;
+            for (size_t j = 0; j < size; j++) {
+                uint32_t value = byteDist(rng);
+                data[j] = value < 4 ? 0x00 : (value < 6 ? 0x01 : static_cast<uint8_t>(rng()));
+            }
+            if (!(ScanAll(FindStartCodeByBytes, data, data + size) ==
+                ScanAll(NalScanner::FindStartCode, data, data + size))) {
+                (void)printf("mismatch in random buffer %u, size %zu, misalign %zu\n", i, size, misalign);
+                return false;
+            }
+        }
+        (void)printf("random buffers: %u matched\n", RANDOM_BUFFERS);
+        return true;
+    }
+
+    // an annex-b stream of h.264 nal units, the payloads carry the emulation prevention bytes.
+    std::vector<uint8_t> MakeStream(std::mt19937 &rng, std::vector<uint32_t> &types)
+    {
+        std::uniform_int_distribution<size_t> payloadDist(1, MAX_NAL_PAYLOAD);
+        std::uniform_int_distribution<uint32_t> typeDist(1, 23);
+        std::vector<uint8_t> stream;
+        stream.reserve(STREAM_SIZE + MAX_NAL_PAYLOAD * 2);
+        while (stream.size() < STREAM_SIZE) {
+            if ((rng() & 1) != 0) {
+                stream.push_back(0x00);
+            }
+            stream.insert(stream.end(), { 0x00, 0x00, 0x01 });
+            uint32_t type = typeDist(rng);
+            types.push_back(type);
+            stream.push_back(static_cast<uint8_t>(0x60 | type));
+            size_t payload = payloadDist(rng);
+            uint32_t zeros = 0;
+            for (size_t i = 0; i < payload; i++) {
+                // compressed payloads look like uniform random bytes
+                uint8_t byte = static_cast<uint8_t>(rng());
+                if (zeros == 2 && byte <= 0x03) {
+                    stream.push_back(0x03);
+                    zeros = 0;
+                }
+                stream.push_back(byte);
+                zeros = byte == 0x00 ? zeros + 1 : 0;
+            }
+            // a nal unit never ends with a zero byte
+            stream.push_back(0x80);
+        }
+        return stream;
+    }
+
+    bool CheckStream(const std::vector<uint8_t> &stream, const std::vector<uint32_t> &types)
+    {
+        const uint8_t *begin = stream.data();
+        const uint8_t *end = begin + stream.size();
+        if (!(ScanAll(FindStartCodeByBytes, begin, end) == ScanAll(NalScanner::FindStartCode, begin, end))) {
+            (void)printf("mismatch in the synthetic stream\n");
+            return false;
+        }
+
+        size_t count = 0;
+        NalUnit nal;
+        const uint8_t *cur = begin;
+        while (NalScanner::NextNalUnit(cur, end, NAL_CODEC_H264, nal)) {
+            if (count >= types.size() || nal.type != types[count]) {
+                (void)printf("nal unit %zu type mismatch\n", count);
+                return false;
+            }
+            count++;
+            cur = nal.end;
+        }
+        if (count != types.size()) {
+            (void)printf("found %zu nal units, %zu expected\n", count, types.size());
+            return false;
+        }
+        (void)printf("synthetic stream: %zu bytes, %zu nal units matched\n", stream.size(), count);
+        return true;
+    }
+
+    double Measure(FindFunc find, const std::vector<uint8_t> &stream, size_t &codes)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t pass = 0; pass < BENCH_PASSES; pass++) {
+            codes += ScanAll(find, stream.data(), stream.data() + stream.size()).size();
+        }
+        std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(stream.size()) * BENCH_PASSES / BYTES_PER_MB / cost.count();
+    }
+}
+
+int main()
+{
+    (void)printf("block path: %s\n", GetBlockPath());
+    std::mt19937 rng(SEED);
+    if (!CheckRandomBuffers(rng)) {
+        return 1;
+    }
+
+    std::vector<uint32_t> types;
+    std::vector<uint8_t> stream = MakeStream(rng, types);
+    if (!CheckStream(stream, types)) {
+        return 1;
+    }
+
+    size_t codes = 0;
+    double byteLoop = Measure(FindStartCodeByBytes, stream, codes);
+    double scanner = Measure(NalScanner::FindStartCode, stream, codes);
+    (void)printf("byte loop: %.0f MB/s, scanner: %.0f MB/s, %u passes, %zu start codes\n",
+        byteLoop, scanner, BENCH_PASSES, codes);
+    return 0;
+}